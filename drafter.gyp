@@ -254,6 +254,11 @@
       'type': '<(libdrafter_type)',
       "conditions" : [
         [ 'libdrafter_type=="shared_library"', { 'defines' : [ 'DRAFTER_BUILD_SHARED' ] }, { 'defines' : [ 'DRAFTER_BUILD_STATIC' ] }],
+        [ 'OS in "linux freebsd openbsd solaris android"', {
+          'cflags' : [ '-pthread' ],
+          'ldflags' : [ '-pthread' ],
+          'link_settings' : { 'ldflags' : [ '-pthread' ] },
+        }],
       ],
       'direct_dependent_settings' : {
         'include_dirs': [
@@ -305,6 +310,9 @@
         "packages/drafter/src/RefractElementFactory.cc",
         "packages/drafter/src/ConversionContext.cc",
         "packages/drafter/src/ConversionContext.h",
+        "packages/drafter/src/GeneratedAssets.cc",
+        "packages/drafter/src/GeneratedAssets.h",
+        "packages/drafter/src/PhaseTimings.h",
         "packages/drafter/src/ElementInfoUtils.h",
         "packages/drafter/src/ElementComparator.h",
 
@@ -319,10 +327,16 @@
         "packages/drafter/src/utils/so/JsonIo.cc",
         "packages/drafter/src/utils/so/YamlIo.h",
         "packages/drafter/src/utils/so/YamlIo.cc",
+        "packages/drafter/src/utils/so/OutputBuffer.h",
+        "packages/drafter/src/utils/so/OutputBuffer.cc",
+        "packages/drafter/src/utils/so/Escape.h",
+        "packages/drafter/src/utils/so/Escape.cc",
         "packages/drafter/src/utils/log/Trivial.h",
         "packages/drafter/src/utils/log/Trivial.cc",
 
         # librefract parts - will be separated into other project
+        "packages/drafter/src/refract/Arena.h",
+        "packages/drafter/src/refract/Arena.cc",
         "packages/drafter/src/refract/Utils.h",
         "packages/drafter/src/refract/Utils.cc",
         "packages/drafter/src/refract/InfoElements.h",
@@ -360,9 +374,13 @@
         "packages/drafter/src/refract/Cardinal.h",
         "packages/drafter/src/refract/SerializeSo.h",
         "packages/drafter/src/refract/SerializeSo.cc",
+        "packages/drafter/src/refract/SerializeStream.h",
+        "packages/drafter/src/refract/SerializeStream.cc",
 
         "packages/drafter/src/refract/Registry.h",
         "packages/drafter/src/refract/Registry.cc",
+        "packages/drafter/src/refract/Symbol.h",
+        "packages/drafter/src/refract/Symbol.cc",
 
         "packages/drafter/src/refract/Query.h",
         "packages/drafter/src/refract/Query.cc",
@@ -381,6 +399,7 @@
         "packages/drafter/src/refract/dsd/Option.h",
         "packages/drafter/src/refract/dsd/Ref.h",
         "packages/drafter/src/refract/dsd/Select.h",
+        "packages/drafter/src/refract/dsd/SourceMap.h",
         "packages/drafter/src/refract/dsd/String.h",
         "packages/drafter/src/refract/dsd/Traits.h",
 
@@ -396,6 +415,7 @@
         "packages/drafter/src/refract/dsd/Option.cc",
         "packages/drafter/src/refract/dsd/Ref.cc",
         "packages/drafter/src/refract/dsd/Select.cc",
+        "packages/drafter/src/refract/dsd/SourceMap.cc",
         "packages/drafter/src/refract/dsd/String.cc",
 
         "packages/drafter/src/backend/MediaTypeS11n.cc",
@@ -439,12 +459,16 @@
         "packages/drafter/test/utils/test-Utf8.cc",
         "packages/drafter/test/utils/so/test-JsonIo.cc",
         "packages/drafter/test/utils/so/test-YamlIo.cc",
+        "packages/drafter/test/utils/so/test-Escape.cc",
 
         "packages/drafter/test/refract/test-Utils.cc",
         "packages/drafter/test/refract/test-JsonSchema.cc",
         "packages/drafter/test/refract/test-JsonValue.cc",
+        "packages/drafter/test/refract/test-SerializeStream.cc",
         "packages/drafter/test/refract/test-ElementSize.cc",
         "packages/drafter/test/refract/test-Cardinal.cc",
+        "packages/drafter/test/refract/test-Arena.cc",
+        "packages/drafter/test/refract/test-Symbol.cc",
 
         "packages/drafter/test/refract/dsd/test-Array.cc",
         "packages/drafter/test/refract/dsd/test-Bool.cc",
@@ -458,16 +482,20 @@
         "packages/drafter/test/refract/dsd/test-Option.cc",
         "packages/drafter/test/refract/dsd/test-Ref.cc",
         "packages/drafter/test/refract/dsd/test-Select.cc",
+        "packages/drafter/test/refract/dsd/test-SourceMap.cc",
         "packages/drafter/test/refract/dsd/test-String.cc",
 
         "packages/drafter/test/refract/dsd/test-Element.cc",
         "packages/drafter/test/refract/dsd/test-InfoElements.cc",
         "packages/drafter/test/refract/test-InfoElementsUtils.cc",
+        "packages/drafter/test/refract/test-ExpandVisitor.cc",
 
         "packages/drafter/test/test-ElementInfoUtils.cc",
         "packages/drafter/test/test-ElementComparator.cc",
         "packages/drafter/test/test-VisitorUtils.cc",
         "packages/drafter/test/test-sourceMapToLineColumn.cc",
+        "packages/drafter/test/test-ConversionContext.cc",
+        "packages/drafter/test/test-NamedTypesRegistry.cc",
 
         "packages/drafter/test/backend/test-MediaTypeS11.cc",
       ],
@@ -475,7 +503,8 @@
         "libdrafter",
       ],
       'conditions': [
-         [ 'OS=="win"', { 'defines' : [ 'WIN' ] } ]
+         [ 'OS=="win"', { 'defines' : [ 'WIN' ] } ],
+         [ 'OS in "linux freebsd openbsd solaris android"', { 'ldflags' : [ '-pthread' ] }],
       ],
     },
 
@@ -485,12 +514,15 @@
       "type": "executable",
       "conditions" : [
         [ 'libdrafter_type=="static_library"', { 'defines' : [ 'DRAFTER_BUILD_STATIC' ] }],
+        [ 'OS in "linux freebsd openbsd solaris android"', { 'ldflags' : [ '-pthread' ] }],
       ],
       "defines": ["LOGGING"],
       "sources": [
         "packages/drafter/src/main.cc",
         "packages/drafter/src/config.cc",
         "packages/drafter/src/config.h",
+        "packages/drafter/src/process.cc",
+        "packages/drafter/src/process.h",
         "packages/drafter/src/reporting.cc",
         "packages/drafter/src/reporting.h",
       ],
@@ -508,6 +540,7 @@
       "type": "executable",
       "conditions" : [
         [ 'libdrafter_type=="static_library"', { 'defines' : [ 'DRAFTER_BUILD_STATIC' ] }],
+        [ 'OS in "linux freebsd openbsd solaris android"', { 'ldflags' : [ '-pthread' ] }],
       ],
       "sources": [
         "packages/drafter/test/test-CAPI.c",
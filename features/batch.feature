@@ -0,0 +1,27 @@
+Feature: Process a batch of blueprints
+
+  Scenario: Validate blueprints listed in a manifest
+
+    Given a file named "manifest.txt" with:
+    """
+    blueprint.apib
+    invalid_blueprint.apib
+    """
+    When I run `drafter --validate --batch manifest.txt -j 2`
+    Then the output should contain:
+    """
+    invalid_blueprint.apib:
+    OK.
+    warning: (5)  unexpected header block, expected a group, resource or an action definition, e.g. '# Group <name>', '# <resource name> [<URI>]' or '# <HTTP method> <URI>' :24:29
+    """
+    And the output should contain "2 documents processed, 0 failed"
+
+  Scenario: Parse blueprints listed in a manifest into Refract JSON files
+
+    Given a file named "manifest.txt" with:
+    """
+    blueprint.apib
+    """
+    When I run `drafter -f json --batch manifest.txt`
+    Then the output should contain "1 documents processed, 0 failed"
+    And the file "blueprint.json" should contain the content of file "refract.json"
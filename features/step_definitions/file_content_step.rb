@@ -10,3 +10,10 @@ Then /^the output should contain the content of file "(.*)"$/ do |filename|
 
   assert_partial_output(expected, all_output)
 end
+
+Then /^the file "(.*)" should contain the content of file "(.*)"$/ do |output, filename|
+  path = File.join(aruba.config.fixtures_directories[0], filename)
+  expected = File.read(path)
+
+  expect(File.read(expand_path(output))).to include(expected)
+end
@@ -85,26 +85,77 @@ static CharactersRange BytesRangeToCharactersRange(const BytesRange& bytesRange,
     return characterRange;
 }
 
-void mdp::BuildCharacterIndex(ByteBufferCharacterIndex& index, const ByteBuffer& byteBuffer)
+/* Number of bits set */
+static size_t popcount(unsigned long long bits)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(bits);
+#else
+    bits = bits - ((bits >> 1) & 0x5555555555555555ULL);
+    bits = (bits & 0x3333333333333333ULL) + ((bits >> 2) & 0x3333333333333333ULL);
+    bits = (bits + (bits >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (bits * 0x0101010101010101ULL) >> 56;
+#endif
+}
+
+static const size_t BlockBits = 64;
+
+size_t ByteBufferCharacterIndex::operator[](size_t pos) const
 {
+    if (pos >= covered_)
+        return 0;
+
+    if (starts_.empty())
+        return pos;
+
+    const size_t block = pos / BlockBits;
+    const size_t offset = pos % BlockBits;
+
+    // starts up to and including pos
+    const unsigned long long mask = offset == BlockBits - 1 ? ~0ULL : (1ULL << (offset + 1)) - 1;
+
+    return checkpoints_[block] + popcount(starts_[block] & mask) - 1;
+}
 
+void mdp::BuildCharacterIndex(ByteBufferCharacterIndex& index, const ByteBuffer& byteBuffer)
+{
     const char* source = byteBuffer.c_str();
     size_t len = byteBuffer.length();
     size_t pos = 0;
-    size_t charPos = 0;
 
-    index.resize(byteBuffer.length());
+    index.size_ = len;
+    index.starts_.clear();
+    index.checkpoints_.clear();
+
+    // single-byte characters map onto themselves
+    while (pos < len && source[pos] && !(source[pos] & 0x80))
+        ++pos;
+
+    if (pos == len || !source[pos]) {
+        index.covered_ = pos;
+        return;
+    }
+
+    const size_t blocks = (len + BlockBits - 1) / BlockBits;
+    index.starts_.assign(blocks, 0);
+
+    for (size_t i = 0; i < pos; ++i)
+        index.starts_[i / BlockBits] |= 1ULL << (i % BlockBits);
 
     while (source[pos] && pos < len) {
-        int charLen = UTF8_CHAR_LEN(source[pos]);
-        pos += charLen;
+        index.starts_[pos / BlockBits] |= 1ULL << (pos % BlockBits);
+        pos += UTF8_CHAR_LEN(source[pos]);
+    }
 
-        while (charLen) {
-            index[pos - charLen] = charPos;
-            charLen--;
-        }
+    // trailing character may be cut short by the end of buffer
+    index.covered_ = pos < len ? pos : len;
+
+    index.checkpoints_.resize(blocks);
 
-        charPos++;
+    size_t characters = 0;
+    for (size_t block = 0; block < blocks; ++block) {
+        index.checkpoints_[block] = characters;
+        characters += popcount(index.starts_[block]);
     }
 }
 
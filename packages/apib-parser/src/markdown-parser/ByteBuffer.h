@@ -70,8 +70,42 @@ namespace mdp
     /** Set of non-continuous character ranges */
     typedef RangeSet<CharactersRange> CharactersRangeSet;
 
-    /** Map byte index into utf-8 chracter index */
-    typedef std::vector<size_t> ByteBufferCharacterIndex;
+    /**
+     *  \brief Map byte index into utf-8 character index
+     *
+     *  Compact replacement of a per-byte lookup table. Buffers without
+     *  multi-byte characters need no table at all; otherwise the start of
+     *  every character is marked in a bitmap and the number of characters
+     *  preceding every 64-byte block is kept as a checkpoint, so a lookup
+     *  is a checkpoint plus a popcount.
+     */
+    class ByteBufferCharacterIndex
+    {
+    public:
+        ByteBufferCharacterIndex() : size_(0), covered_(0) {}
+
+        /** Number of indexed bytes */
+        size_t size() const
+        {
+            return size_;
+        }
+
+        bool empty() const
+        {
+            return size_ == 0;
+        }
+
+        /** Index of character the byte at given position belongs to */
+        size_t operator[](size_t pos) const;
+
+    private:
+        friend void BuildCharacterIndex(ByteBufferCharacterIndex& index, const ByteBuffer& byteBuffer);
+
+        size_t size_;
+        size_t covered_;                         // bytes belonging to a character; 0 is reported past them
+        std::vector<unsigned long long> starts_; // bit per byte, set where a character starts; empty if ASCII only
+        std::vector<size_t> checkpoints_;        // characters starting before each 64-byte block
+    };
 
     /** Fill character map - cache of characters positions */
     void BuildCharacterIndex(ByteBufferCharacterIndex& index, const ByteBuffer& byteBuffer);
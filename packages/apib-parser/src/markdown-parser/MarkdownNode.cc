@@ -6,6 +6,9 @@
 //  Copyright (c) 2014 Apiary Inc. All rights reserved.
 //
 
+#include <algorithm>
+#include <cstring>
+
 #ifdef DEBUG
 #include <iostream>
 #endif
@@ -14,10 +17,133 @@
 
 using namespace mdp;
 
-MarkdownNode::MarkdownNode(MarkdownNodeType type_, MarkdownNode* parent_, const ByteBuffer& text_, const Data& data_)
+MarkdownNodeText::MarkdownNodeText() : m_location(0), m_length(0) {}
+
+MarkdownNodeText::MarkdownNodeText(const ByteBuffer& text) : m_location(0), m_length(text.length())
+{
+    if (!text.empty())
+        m_buffer = std::make_shared<const ByteBuffer>(text);
+}
+
+MarkdownNodeText::MarkdownNodeText(const char* text) : m_location(0), m_length(0)
+{
+    if (text && *text) {
+        m_buffer = std::make_shared<const ByteBuffer>(text);
+        m_length = m_buffer->length();
+    }
+}
+
+MarkdownNodeText::MarkdownNodeText(
+    const std::shared_ptr<const ByteBuffer>& buffer, size_type location, size_type length)
+    : m_buffer(buffer), m_location(location), m_length(length)
+{
+    if (!m_buffer || m_location + m_length > m_buffer->length())
+        throw "text slice out of buffer bounds";
+}
+
+const char* MarkdownNodeText::data() const
+{
+    return m_buffer ? m_buffer->data() + m_location : "";
+}
+
+MarkdownNodeText::size_type MarkdownNodeText::length() const
+{
+    return m_length;
+}
+
+MarkdownNodeText::size_type MarkdownNodeText::size() const
+{
+    return m_length;
+}
+
+bool MarkdownNodeText::empty() const
+{
+    return m_length == 0;
+}
+
+char MarkdownNodeText::operator[](size_type pos) const
+{
+    return data()[pos];
+}
+
+int MarkdownNodeText::compare(const char* text, size_type length) const
+{
+    int result = ::memcmp(data(), text, std::min(m_length, length));
+    if (result != 0)
+        return result;
+
+    return (m_length < length) ? -1 : (m_length > length) ? 1 : 0;
+}
+
+ByteBuffer MarkdownNodeText::str() const
+{
+    return ByteBuffer(data(), m_length);
+}
+
+MarkdownNodeText::operator ByteBuffer() const
+{
+    return str();
+}
+
+bool mdp::operator==(const MarkdownNodeText& lhs, const MarkdownNodeText& rhs)
+{
+    return lhs.compare(rhs.data(), rhs.length()) == 0;
+}
+
+bool mdp::operator==(const MarkdownNodeText& lhs, const ByteBuffer& rhs)
+{
+    return lhs.compare(rhs.data(), rhs.length()) == 0;
+}
+
+bool mdp::operator==(const ByteBuffer& lhs, const MarkdownNodeText& rhs)
+{
+    return rhs == lhs;
+}
+
+bool mdp::operator==(const MarkdownNodeText& lhs, const char* rhs)
+{
+    return lhs.compare(rhs, ::strlen(rhs)) == 0;
+}
+
+bool mdp::operator==(const char* lhs, const MarkdownNodeText& rhs)
+{
+    return rhs == lhs;
+}
+
+bool mdp::operator!=(const MarkdownNodeText& lhs, const MarkdownNodeText& rhs)
+{
+    return !(lhs == rhs);
+}
+
+bool mdp::operator!=(const MarkdownNodeText& lhs, const ByteBuffer& rhs)
+{
+    return !(lhs == rhs);
+}
+
+bool mdp::operator!=(const ByteBuffer& lhs, const MarkdownNodeText& rhs)
+{
+    return !(lhs == rhs);
+}
+
+bool mdp::operator!=(const MarkdownNodeText& lhs, const char* rhs)
+{
+    return !(lhs == rhs);
+}
+
+bool mdp::operator!=(const char* lhs, const MarkdownNodeText& rhs)
+{
+    return !(lhs == rhs);
+}
+
+std::ostream& mdp::operator<<(std::ostream& os, const MarkdownNodeText& text)
+{
+    return os.write(text.data(), text.length());
+}
+
+MarkdownNode::MarkdownNode(
+    MarkdownNodeType type_, MarkdownNode* parent_, const MarkdownNodeText& text_, const Data& data_)
     : type(type_), text(text_), data(data_), m_parent(parent_)
 {
-    m_children.reset(::new MarkdownNodes);
 }
 
 MarkdownNode::MarkdownNode(const MarkdownNode& rhs)
@@ -26,23 +152,59 @@ MarkdownNode::MarkdownNode(const MarkdownNode& rhs)
     this->text = rhs.text;
     this->data = rhs.data;
     this->sourceMap = rhs.sourceMap;
-    this->m_children.reset(::new MarkdownNodes(*rhs.m_children.get()));
+    if (rhs.m_children.get())
+        this->m_children.reset(::new MarkdownNodes(*rhs.m_children.get()));
     this->m_parent = rhs.m_parent;
 }
 
+MarkdownNode::MarkdownNode(MarkdownNode&& rhs)
+    : type(rhs.type)
+    , text(std::move(rhs.text))
+    , data(rhs.data)
+    , sourceMap(std::move(rhs.sourceMap))
+    , m_parent(rhs.m_parent)
+    , m_children(std::move(rhs.m_children))
+{
+    adoptChildren();
+}
+
 MarkdownNode& MarkdownNode::operator=(const MarkdownNode& rhs)
 {
     this->type = rhs.type;
     this->text = rhs.text;
     this->data = rhs.data;
     this->sourceMap = rhs.sourceMap;
-    this->m_children.reset(::new MarkdownNodes(*rhs.m_children.get()));
+    if (rhs.m_children.get())
+        this->m_children.reset(::new MarkdownNodes(*rhs.m_children.get()));
+    else
+        this->m_children.reset();
     this->m_parent = rhs.m_parent;
     return *this;
 }
 
+MarkdownNode& MarkdownNode::operator=(MarkdownNode&& rhs)
+{
+    this->type = rhs.type;
+    this->text = std::move(rhs.text);
+    this->data = rhs.data;
+    this->sourceMap = std::move(rhs.sourceMap);
+    this->m_children = std::move(rhs.m_children);
+    this->m_parent = rhs.m_parent;
+    adoptChildren();
+    return *this;
+}
+
 MarkdownNode::~MarkdownNode() {}
 
+void MarkdownNode::adoptChildren()
+{
+    if (!m_children.get())
+        return;
+
+    for (MarkdownNodeIterator it = m_children->begin(); it != m_children->end(); ++it)
+        it->m_parent = this;
+}
+
 MarkdownNode& MarkdownNode::parent()
 {
     if (!hasParent())
@@ -70,15 +232,17 @@ bool MarkdownNode::hasParent() const
 MarkdownNodes& MarkdownNode::children()
 {
     if (!m_children.get())
-        throw "no children set";
+        m_children.reset(::new MarkdownNodes);
 
     return *m_children;
 }
 
 const MarkdownNodes& MarkdownNode::children() const
 {
+    static const MarkdownNodes empty;
+
     if (!m_children.get())
-        throw "no children set";
+        return empty;
 
     return *m_children;
 }
@@ -141,7 +305,7 @@ void MarkdownNode::printNode(size_t level) const
 
     cerr << std::endl;
 
-    for (MarkdownNodeIterator it = m_children->begin(); it != m_children->end(); ++it) {
+    for (MarkdownNodes::const_iterator it = children().begin(); it != children().end(); ++it) {
         it->printNode(level + 1);
     }
 
@@ -11,6 +11,7 @@
 
 #include <deque>
 #include <memory>
+#include <ostream>
 #include "ByteBuffer.h"
 
 namespace mdp
@@ -35,6 +36,64 @@ namespace mdp
         UndefinedMarkdownNodeType = -1
     };
 
+    /**
+     *  \brief Textual content of an AST node
+     *
+     *  Text sundown passes through unchanged is kept as a slice of the
+     *  parsed source, only transformed text (e.g. de-indented code blocks)
+     *  has a buffer of its own. Copies share the underlying buffer.
+     */
+    class MarkdownNodeText
+    {
+    public:
+        typedef ByteBuffer::size_type size_type;
+
+        /** Empty text */
+        MarkdownNodeText();
+
+        /** Owned copy of a text */
+        MarkdownNodeText(const ByteBuffer& text);
+        MarkdownNodeText(const char* text);
+
+        /** Slice of a shared buffer */
+        MarkdownNodeText(const std::shared_ptr<const ByteBuffer>& buffer, size_type location, size_type length);
+
+        /** Text data, not null terminated */
+        const char* data() const;
+
+        size_type length() const;
+        size_type size() const;
+        bool empty() const;
+
+        char operator[](size_type pos) const;
+
+        /** Compare with a sequence of bytes, see std::string::compare */
+        int compare(const char* text, size_type length) const;
+
+        /** Copy of the text */
+        ByteBuffer str() const;
+        operator ByteBuffer() const;
+
+    private:
+        std::shared_ptr<const ByteBuffer> m_buffer;
+        size_type m_location;
+        size_type m_length;
+    };
+
+    bool operator==(const MarkdownNodeText& lhs, const MarkdownNodeText& rhs);
+    bool operator==(const MarkdownNodeText& lhs, const ByteBuffer& rhs);
+    bool operator==(const ByteBuffer& lhs, const MarkdownNodeText& rhs);
+    bool operator==(const MarkdownNodeText& lhs, const char* rhs);
+    bool operator==(const char* lhs, const MarkdownNodeText& rhs);
+
+    bool operator!=(const MarkdownNodeText& lhs, const MarkdownNodeText& rhs);
+    bool operator!=(const MarkdownNodeText& lhs, const ByteBuffer& rhs);
+    bool operator!=(const ByteBuffer& lhs, const MarkdownNodeText& rhs);
+    bool operator!=(const MarkdownNodeText& lhs, const char* rhs);
+    bool operator!=(const char* lhs, const MarkdownNodeText& rhs);
+
+    std::ostream& operator<<(std::ostream& os, const MarkdownNodeText& text);
+
     /* Forward declaration of AST Node */
     class MarkdownNode;
 
@@ -53,7 +112,7 @@ namespace mdp
         MarkdownNodeType type;
 
         /** Textual content, where applicable */
-        ByteBuffer text;
+        MarkdownNodeText text;
 
         /** Additinonal data, if applicable */
         Data data;
@@ -78,15 +137,21 @@ namespace mdp
         /** Constructor */
         MarkdownNode(MarkdownNodeType type_ = UndefinedMarkdownNodeType,
             MarkdownNode* parent_ = NULL,
-            const ByteBuffer& text_ = ByteBuffer(),
+            const MarkdownNodeText& text_ = MarkdownNodeText(),
             const Data& data_ = Data());
 
         /** Copy constructor */
         MarkdownNode(const MarkdownNode& rhs);
 
+        /** Move constructor, children are re-parented */
+        MarkdownNode(MarkdownNode&& rhs);
+
         /** Assignment operator */
         MarkdownNode& operator=(const MarkdownNode& rhs);
 
+        /** Move assignment operator, children are re-parented */
+        MarkdownNode& operator=(MarkdownNode&& rhs);
+
         /** Destructor */
         ~MarkdownNode();
 
@@ -97,7 +162,11 @@ namespace mdp
 
     private:
         MarkdownNode* m_parent;
+
+        /** Allocated on first non-const access, most nodes are leaves */
         std::unique_ptr<MarkdownNodes> m_children;
+
+        void adoptChildren();
     };
 
     /** Markdown AST nodes collection iterator */
@@ -6,6 +6,7 @@
 //  Copyright (c) 2014 Apiary Inc. All rights reserved.
 //
 
+#include <algorithm>
 #include <cstring>
 #include <stdexcept>
 #include "MarkdownParser.h"
@@ -31,16 +32,34 @@ static ByteBuffer ByteBufferFromSundown(const struct buf* text)
     return ByteBuffer(reinterpret_cast<char*>(text->data), text->size);
 }
 
-MarkdownParser::MarkdownParser() : m_workingNode(NULL), m_listBlockContext(false), m_source(NULL), m_sourceLength(0) {}
+MarkdownParser::MarkdownParser()
+    : m_workingNode(NULL), m_listBlockContext(false), m_source(NULL), m_sourceLength(0), m_textNode(NULL)
+{
+}
 
 void MarkdownParser::parse(const ByteBuffer& source, MarkdownNode& ast)
 {
+    // Not owned, the caller keeps the source alive
+    parseSource(std::shared_ptr<const ByteBuffer>(std::shared_ptr<const ByteBuffer>(), &source), ast);
+}
+
+void MarkdownParser::parse(ByteBuffer&& source, MarkdownNode& ast)
+{
+    parseSource(std::make_shared<const ByteBuffer>(std::move(source)), ast);
+}
+
+void MarkdownParser::parseSource(const std::shared_ptr<const ByteBuffer>& sharedSource, MarkdownNode& ast)
+{
+    const ByteBuffer& source = *sharedSource;
+
     ast = MarkdownNode();
     m_workingNode = &ast;
     m_workingNode->type = RootMarkdownNodeType;
     m_workingNode->sourceMap.push_back(BytesRange(0, source.length()));
     m_source = &source;
     m_sourceLength = source.length();
+    m_sharedSource = sharedSource;
+    m_textNode = NULL;
     m_listBlockContext = false;
 
     RenderCallbacks callbacks = renderCallbacks();
@@ -53,12 +72,71 @@ void MarkdownParser::parse(const ByteBuffer& source, MarkdownNode& ast)
     ::bufrelease(output);
     ::sd_markdown_free(sundown);
 
+    commitText();
+
     m_workingNode = NULL;
     m_source = NULL;
     m_sourceLength = 0;
+    m_sharedSource.reset();
     m_listBlockContext = false;
 }
 
+const ByteBuffer& MarkdownParser::textFromSundown(const struct buf* text)
+{
+    // The buffer is about to be reused
+    commitText();
+
+    if (!text || !text->data || !text->size)
+        m_text.clear();
+    else
+        m_text.assign(reinterpret_cast<char*>(text->data), text->size);
+
+    return m_text;
+}
+
+void MarkdownParser::deferText(MarkdownNode& node, const ByteBuffer& text)
+{
+    commitText();
+
+    if (&text != &m_text)
+        m_text = text;
+
+    m_textNode = &node;
+}
+
+void MarkdownParser::commitText()
+{
+    if (!m_textNode)
+        return;
+
+    MarkdownNode& node = *m_textNode;
+    m_textNode = NULL;
+
+    if (m_text.empty()) {
+        node.text = MarkdownNodeText();
+        return;
+    }
+
+    // Text sundown did not transform is found within the node's source map
+    const char* source = m_source->data();
+    for (BytesRangeSet::const_iterator it = node.sourceMap.begin(); it != node.sourceMap.end(); ++it) {
+
+        if (it->length < m_text.length() || it->location + it->length > m_sourceLength)
+            continue;
+
+        const char* begin = source + it->location;
+        const char* end = begin + it->length;
+        const char* found = std::search(begin, end, m_text.begin(), m_text.end());
+
+        if (found != end) {
+            node.text = MarkdownNodeText(m_sharedSource, found - source, m_text.length());
+            return;
+        }
+    }
+
+    node.text = MarkdownNodeText(m_text);
+}
+
 MarkdownParser::RenderCallbacks MarkdownParser::renderCallbacks()
 {
     RenderCallbacks callbacks;
@@ -97,7 +175,7 @@ void MarkdownParser::renderHeader(struct buf* ob, const struct buf* text, int le
         return;
 
     MarkdownParser* p = static_cast<MarkdownParser*>(opaque);
-    p->renderHeader(ByteBufferFromSundown(text), level);
+    p->renderHeader(p->textFromSundown(text), level);
 }
 
 void MarkdownParser::renderHeader(const ByteBuffer& text, int level)
@@ -105,8 +183,8 @@ void MarkdownParser::renderHeader(const ByteBuffer& text, int level)
     if (!m_workingNode)
         throw NO_WORKING_NODE_ERR;
 
-    MarkdownNode node(HeaderMarkdownNodeType, m_workingNode, text, level);
-    m_workingNode->children().push_back(node);
+    m_workingNode->children().push_back(MarkdownNode(HeaderMarkdownNodeType, m_workingNode, MarkdownNodeText(), level));
+    deferText(m_workingNode->children().back(), text);
 }
 
 void MarkdownParser::beginList(int flags, void* opaque)
@@ -130,7 +208,7 @@ void MarkdownParser::renderList(struct buf* ob, const struct buf* text, int flag
         return;
 
     MarkdownParser* p = static_cast<MarkdownParser*>(opaque);
-    p->renderList(ByteBufferFromSundown(text), flags);
+    p->renderList(ByteBuffer(), flags);
 }
 
 void MarkdownParser::renderList(const ByteBuffer& text, int flags)
@@ -152,8 +230,8 @@ void MarkdownParser::beginListItem(int flags)
     if (!m_workingNode)
         throw NO_WORKING_NODE_ERR;
 
-    MarkdownNode node(ListItemMarkdownNodeType, m_workingNode, ByteBuffer(), flags);
-    m_workingNode->children().push_back(node);
+    m_workingNode->children().push_back(
+        MarkdownNode(ListItemMarkdownNodeType, m_workingNode, MarkdownNodeText(), flags));
 
     // Push context
     m_workingNode = &m_workingNode->children().back();
@@ -165,7 +243,7 @@ void MarkdownParser::renderListItem(struct buf* ob, const struct buf* text, int
         return;
 
     MarkdownParser* p = static_cast<MarkdownParser*>(opaque);
-    p->renderListItem(ByteBufferFromSundown(text), flags);
+    p->renderListItem(p->textFromSundown(text), flags);
 }
 
 void MarkdownParser::renderListItem(const ByteBuffer& text, int flags)
@@ -180,8 +258,8 @@ void MarkdownParser::renderListItem(const ByteBuffer& text, int flags)
     // Instead of storing the text on the list item
     // create the artificial paragraph node to store the text.
     if (m_workingNode->children().empty() || m_workingNode->children().front().type != ParagraphMarkdownNodeType) {
-        MarkdownNode textNode(ParagraphMarkdownNodeType, m_workingNode, text);
-        m_workingNode->children().push_front(textNode);
+        m_workingNode->children().push_front(MarkdownNode(ParagraphMarkdownNodeType, m_workingNode));
+        deferText(m_workingNode->children().front(), text);
     }
 
     m_workingNode->data = flags;
@@ -196,7 +274,7 @@ void MarkdownParser::renderBlockCode(struct buf* ob, const struct buf* text, con
         return;
 
     MarkdownParser* p = static_cast<MarkdownParser*>(opaque);
-    p->renderBlockCode(ByteBufferFromSundown(text), ByteBufferFromSundown(lang));
+    p->renderBlockCode(p->textFromSundown(text), ByteBufferFromSundown(lang));
 }
 
 void MarkdownParser::renderBlockCode(const ByteBuffer& text, const ByteBuffer& language)
@@ -204,8 +282,8 @@ void MarkdownParser::renderBlockCode(const ByteBuffer& text, const ByteBuffer& l
     if (!m_workingNode)
         throw NO_WORKING_NODE_ERR;
 
-    MarkdownNode node(CodeMarkdownNodeType, m_workingNode, text);
-    m_workingNode->children().push_back(node);
+    m_workingNode->children().push_back(MarkdownNode(CodeMarkdownNodeType, m_workingNode));
+    deferText(m_workingNode->children().back(), text);
 }
 
 void MarkdownParser::renderParagraph(struct buf* ob, const struct buf* text, void* opaque)
@@ -214,7 +292,7 @@ void MarkdownParser::renderParagraph(struct buf* ob, const struct buf* text, voi
         return;
 
     MarkdownParser* p = static_cast<MarkdownParser*>(opaque);
-    p->renderParagraph(ByteBufferFromSundown(text));
+    p->renderParagraph(p->textFromSundown(text));
 }
 
 void MarkdownParser::renderParagraph(const ByteBuffer& text)
@@ -222,8 +300,8 @@ void MarkdownParser::renderParagraph(const ByteBuffer& text)
     if (!m_workingNode)
         throw NO_WORKING_NODE_ERR;
 
-    MarkdownNode node(ParagraphMarkdownNodeType, m_workingNode, text);
-    m_workingNode->children().push_back(node);
+    m_workingNode->children().push_back(MarkdownNode(ParagraphMarkdownNodeType, m_workingNode));
+    deferText(m_workingNode->children().back(), text);
 }
 
 void MarkdownParser::renderHorizontalRule(struct buf* ob, void* opaque)
@@ -240,8 +318,7 @@ void MarkdownParser::renderHorizontalRule()
     if (!m_workingNode)
         throw NO_WORKING_NODE_ERR;
 
-    MarkdownNode node(HRuleMarkdownNodeType, m_workingNode, ByteBuffer(), MarkdownNode::Data());
-    m_workingNode->children().push_back(node);
+    m_workingNode->children().push_back(MarkdownNode(HRuleMarkdownNodeType, m_workingNode));
 }
 
 void MarkdownParser::renderHTML(struct buf* ob, const struct buf* text, void* opaque)
@@ -250,7 +327,7 @@ void MarkdownParser::renderHTML(struct buf* ob, const struct buf* text, void* op
         return;
 
     MarkdownParser* p = static_cast<MarkdownParser*>(opaque);
-    p->renderHTML(ByteBufferFromSundown(text));
+    p->renderHTML(p->textFromSundown(text));
 }
 
 void MarkdownParser::renderHTML(const ByteBuffer& text)
@@ -258,8 +335,8 @@ void MarkdownParser::renderHTML(const ByteBuffer& text)
     if (!m_workingNode)
         throw NO_WORKING_NODE_ERR;
 
-    MarkdownNode node(HTMLMarkdownNodeType, m_workingNode, text);
-    m_workingNode->children().push_back(node);
+    m_workingNode->children().push_back(MarkdownNode(HTMLMarkdownNodeType, m_workingNode));
+    deferText(m_workingNode->children().back(), text);
 }
 
 void MarkdownParser::beginQuote(void* opaque)
@@ -276,8 +353,7 @@ void MarkdownParser::beginQuote()
     if (!m_workingNode)
         throw NO_WORKING_NODE_ERR;
 
-    MarkdownNode node(QuoteMarkdownNodeType, m_workingNode);
-    m_workingNode->children().push_back(node);
+    m_workingNode->children().push_back(MarkdownNode(QuoteMarkdownNodeType, m_workingNode));
 
     // Push context
     m_workingNode = &m_workingNode->children().back();
@@ -289,7 +365,7 @@ void MarkdownParser::renderQuote(struct buf* ob, const struct buf* text, void* o
         return;
 
     MarkdownParser* p = static_cast<MarkdownParser*>(opaque);
-    p->renderQuote(ByteBufferFromSundown(text));
+    p->renderQuote(p->textFromSundown(text));
 }
 
 void MarkdownParser::renderQuote(const ByteBuffer& text)
@@ -300,7 +376,7 @@ void MarkdownParser::renderQuote(const ByteBuffer& text)
     if (m_workingNode->type != QuoteMarkdownNodeType)
         throw WORKING_NODE_MISMATCH_ERR;
 
-    m_workingNode->text = text;
+    deferText(*m_workingNode, text);
 
     // Pop context
     m_workingNode = &m_workingNode->parent();
@@ -360,19 +436,25 @@ void MarkdownParser::blockDidParse(const BytesRangeSet& sourceMap)
     if (lMarkdownNode.type == ListItemMarkdownNodeType && !lMarkdownNode.children().empty()
         && lMarkdownNode.children().front().sourceMap.empty()) {
 
-        ByteBuffer& buffer = lMarkdownNode.children().front().text;
+        MarkdownNode& textNode = lMarkdownNode.children().front();
+        const bool deferred = (&textNode == m_textNode);
+        const char* text = deferred ? m_text.data() : textNode.text.data();
+        size_t length = deferred ? m_text.length() : textNode.text.length();
+
         ByteBuffer mapped = MapBytesRangeSet(sourceMap, *m_source);
-        size_t pos = mapped.find(buffer);
+        size_t pos = mapped.find(text, 0, length);
 
         if (pos != mapped.npos) {
             BytesRange range = sourceMap.front();
             range.location += pos;
-            range.length = buffer.length();
+            range.length = length;
             BytesRangeSet newMap;
             newMap.push_back(range);
-            lMarkdownNode.children().front().sourceMap.append(newMap);
+            textNode.sourceMap.append(newMap);
         } else {
-            lMarkdownNode.children().front().sourceMap.append(sourceMap);
+            textNode.sourceMap.append(sourceMap);
         }
     }
+
+    commitText();
 }
@@ -40,15 +40,42 @@ namespace mdp
          *
          *  \param source   Markdown source data to be parsed
          *  \param ast      Parsed AST (root node)
+         *
+         *  Node texts reference the source, it must outlive the AST.
          */
         void parse(const ByteBuffer& source, MarkdownNode& ast);
 
+        /**
+         *  \brief Parse source buffer, the AST takes over the source
+         */
+        void parse(ByteBuffer&& source, MarkdownNode& ast);
+
     private:
         MarkdownNode* m_workingNode;
         bool m_listBlockContext;
         const ByteBuffer* m_source;
         size_t m_sourceLength;
 
+        /** Source as shared by node text slices */
+        std::shared_ptr<const ByteBuffer> m_sharedSource;
+
+        /** Node waiting for its source map to settle its text */
+        MarkdownNode* m_textNode;
+
+        /** Last text produced by sundown, reused across blocks */
+        ByteBuffer m_text;
+
+        void parseSource(const std::shared_ptr<const ByteBuffer>& source, MarkdownNode& ast);
+
+        /** Copy sundown text into the reused text buffer */
+        const ByteBuffer& textFromSundown(const struct buf* text);
+
+        /** Defer text of a node until its source map is known */
+        void deferText(MarkdownNode& node, const ByteBuffer& text);
+
+        /** Set the deferred text as a source slice, if possible, or a copy */
+        void commitText();
+
         static const size_t OutputUnitSize;
         static const size_t MaxNesting;
         static const int ParserExtensions;
@@ -126,7 +126,7 @@ namespace snowcrash
             } else {
 
                 if (!out.node.body.empty() || node->type != mdp::ParagraphMarkdownNodeType
-                    || !parseModelReference(node, pd, node->text, out)) {
+                    || !parseModelReference(node, pd, out)) {
 
                     // NOTE: NOT THE CORRECT WAY TO DO THIS
                     // https://github.com/apiaryio/snowcrash/commit/a7c5868e62df0048a85e2f9aeeb42c3b3e0a2f07#commitcomment-7322085
@@ -505,6 +505,17 @@ namespace snowcrash
             return true;
         }
 
+        /** Model reference given by the node text, the text is left trimmed */
+        static bool parseModelReference(
+            const MarkdownNodeIterator& node, SectionParserData& pd, const ParseResultRef<Payload>& out)
+        {
+            mdp::ByteBuffer source = node->text;
+            bool result = parseModelReference(node, pd, source, out);
+            node->text = source;
+
+            return result;
+        }
+
         /** Given the reference id(name), initializes reference of the payload accordingly (if possible resolve it) */
         static bool parseModelReference(const MarkdownNodeIterator& node,
             SectionParserData& pd,
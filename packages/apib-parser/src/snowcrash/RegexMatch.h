@@ -15,6 +15,9 @@
 namespace snowcrash
 {
 
+    // Regular expressions are compiled once per process and shared between
+    // calls (and threads), keyed by the expression string.
+
     // Perform snowcrash-specific regex evaluation
     // returns true if target string matches given expression, false otherwise
     bool RegexMatch(const std::string& target, const std::string& expression);
@@ -27,6 +30,7 @@ namespace snowcrash
 
     // Performs posix-regex
     // returns true if target string matches given expression, false otherwise
+    // strings already held by captureGroups are reused for the captured groups
     bool RegexCapture(
         const std::string& target, const std::string& expression, CaptureGroups& captureGroups, size_t groupSize = 8);
 }
@@ -8,38 +8,88 @@
 
 #include <regex.h>
 #include <cstring>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 #include "../RegexMatch.h"
 
-// FIXME: Migrate to C++11.
-// Naive implementation of regex matching using POSIX regex
+namespace
+{
+    // Capture groups up to this size are matched without a heap allocation
+    const size_t InlineGroupSize = 16;
+
+    // POSIX regex compiled once and kept for the lifetime of the process
+    class CompiledRegex
+    {
+        regex_t regex_;
+        bool valid_;
+
+    public:
+        explicit CompiledRegex(const std::string& expression)
+            : valid_(::regcomp(&regex_, expression.c_str(), REG_EXTENDED) == 0)
+        {
+        }
+
+        ~CompiledRegex()
+        {
+            if (valid_)
+                ::regfree(&regex_);
+        }
+
+        CompiledRegex(const CompiledRegex&) = delete;
+        CompiledRegex& operator=(const CompiledRegex&) = delete;
+
+        const regex_t* get() const noexcept
+        {
+            return valid_ ? &regex_ : nullptr;
+        }
+    };
+
+    // Process-wide registry of compiled regular expressions
+    //
+    // Patterns used by snowcrash are a fixed set of constants, so the registry
+    // is never pruned. Compiled expressions are only read after insertion,
+    // `regexec` is safe to call concurrently on them.
+    class RegexRegistry
+    {
+        std::mutex mtx_;
+        std::unordered_map<std::string, std::unique_ptr<CompiledRegex> > compiled_;
+
+    public:
+        static RegexRegistry& instance()
+        {
+            static RegexRegistry instance_;
+            return instance_;
+        }
+
+        // returns nullptr if expression does not compile
+        const regex_t* get(const std::string& expression)
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+
+            auto& entry = compiled_[expression];
+            if (!entry)
+                entry.reset(new CompiledRegex(expression));
+
+            return entry->get();
+        }
+    };
+}
+
 bool snowcrash::RegexMatch(const std::string& target, const std::string& expression)
 {
     if (target.empty() || expression.empty())
         return false;
 
-    regex_t regex;
-    int reti = ::regcomp(&regex, expression.c_str(), REG_EXTENDED | REG_NOSUB);
-    if (reti) {
+    const regex_t* regex = RegexRegistry::instance().get(expression);
+    if (!regex) {
         // Unable to compile regex
         return false;
     }
 
     // Execute regular expression
-    reti = ::regexec(&regex, target.c_str(), 0, NULL, 0);
-    if (!reti) {
-        ::regfree(&regex);
-        return true;
-    } else if (reti == REG_NOMATCH) {
-        ::regfree(&regex);
-        return false;
-    } else {
-        char msgbuf[1024];
-        regerror(reti, &regex, msgbuf, sizeof(msgbuf));
-        ::regfree(&regex);
-        return false;
-    }
-
-    return false;
+    return ::regexec(regex, target.c_str(), 0, NULL, 0) == 0;
 }
 
 std::string snowcrash::RegexCaptureFirst(const std::string& target, const std::string& expression)
@@ -57,37 +107,42 @@ bool snowcrash::RegexCapture(
     if (target.empty() || expression.empty())
         return false;
 
-    captureGroups.clear();
-
     try {
-        regex_t regex;
-        int reti = ::regcomp(&regex, expression.c_str(), REG_EXTENDED);
-        if (reti)
+        const regex_t* regex = RegexRegistry::instance().get(expression);
+        if (!regex) {
+            captureGroups.clear();
             return false;
+        }
 
-        regmatch_t* pmatch = ::new regmatch_t[groupSize];
+        regmatch_t inlineMatch[InlineGroupSize];
+        std::vector<regmatch_t> heapMatch;
+
+        regmatch_t* pmatch = inlineMatch;
+        if (groupSize > InlineGroupSize) {
+            heapMatch.resize(groupSize);
+            pmatch = heapMatch.data();
+        }
         ::memset(pmatch, 0, sizeof(regmatch_t) * groupSize);
 
-        reti = ::regexec(&regex, target.c_str(), groupSize, pmatch, 0);
-        if (!reti) {
-            ::regfree(&regex);
-
-            for (size_t i = 0; i < groupSize; ++i) {
-                if (pmatch[i].rm_so == -1 || pmatch[i].rm_eo == -1)
-                    captureGroups.push_back(std::string());
-                else
-                    captureGroups.push_back(std::string(target, pmatch[i].rm_so, pmatch[i].rm_eo - pmatch[i].rm_so));
-            }
-
-            delete[] pmatch;
-            return true;
-        } else {
-            ::regfree(&regex);
-            delete[] pmatch;
+        if (::regexec(regex, target.c_str(), groupSize, pmatch, 0) != 0) {
+            captureGroups.clear();
             return false;
         }
+
+        // reuse strings already held by captureGroups
+        captureGroups.resize(groupSize);
+
+        for (size_t i = 0; i < groupSize; ++i) {
+            if (pmatch[i].rm_so == -1 || pmatch[i].rm_eo == -1)
+                captureGroups[i].clear();
+            else
+                captureGroups[i].assign(target, pmatch[i].rm_so, pmatch[i].rm_eo - pmatch[i].rm_so);
+        }
+
+        return true;
     } catch (...) {
     }
 
+    captureGroups.clear();
     return false;
 }
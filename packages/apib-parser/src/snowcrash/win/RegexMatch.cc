@@ -8,6 +8,9 @@
 
 #include <regex>
 #include <cstring>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 #include "../RegexMatch.h"
 
 using namespace std;
@@ -19,14 +22,45 @@ using namespace std::tr1;
 // A C++09 implementation
 //
 
+namespace
+{
+    // Process-wide registry of compiled regular expressions
+    //
+    // Patterns used by snowcrash are a fixed set of constants, so the registry
+    // is never pruned. Compiled expressions are only read after insertion.
+    class RegexRegistry
+    {
+        mutex mtx_;
+        unordered_map<string, unique_ptr<regex> > compiled_;
+
+    public:
+        static RegexRegistry& instance()
+        {
+            static RegexRegistry instance_;
+            return instance_;
+        }
+
+        // throws regex_error if expression does not compile
+        const regex& get(const string& expression)
+        {
+            lock_guard<mutex> lock(mtx_);
+
+            auto& entry = compiled_[expression];
+            if (!entry)
+                entry.reset(new regex(expression, regex_constants::extended));
+
+            return *entry;
+        }
+    };
+}
+
 bool snowcrash::RegexMatch(const string& target, const string& expression)
 {
     if (target.empty() || expression.empty())
         return false;
 
     try {
-        regex pattern(expression, regex_constants::extended);
-        return regex_search(target, pattern);
+        return regex_search(target, RegexRegistry::instance().get(expression));
     } catch (const regex_error&) {
     } catch (...) {
     }
@@ -49,18 +83,24 @@ bool snowcrash::RegexCapture(
     if (target.empty() || expression.empty())
         return false;
 
-    captureGroups.clear();
-
     try {
 
-        regex pattern(expression, regex_constants::extended);
         match_results<string::const_iterator> result;
-        if (!regex_search(target, result, pattern))
+        if (!regex_search(target, result, RegexRegistry::instance().get(expression))) {
+            captureGroups.clear();
             return false;
+        }
+
+        // reuse strings already held by captureGroups
+        captureGroups.resize(result.size());
 
-        for (match_results<string::const_iterator>::const_iterator it = result.begin(); it != result.end(); ++it) {
+        size_t i = 0;
+        for (match_results<string::const_iterator>::const_iterator it = result.begin(); it != result.end(); ++it, ++i) {
 
-            captureGroups.push_back(*it);
+            if (it->matched)
+                captureGroups[i].assign(it->first, it->second);
+            else
+                captureGroups[i].clear();
         }
 
         return true;
@@ -68,5 +108,6 @@ bool snowcrash::RegexCapture(
     } catch (...) {
     }
 
+    captureGroups.clear();
     return false;
 }
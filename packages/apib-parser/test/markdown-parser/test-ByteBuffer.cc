@@ -180,3 +180,77 @@ TEST_CASE("Byte buffer and Index should return equal char ranges", "[bytebuffer]
     REQUIRE(charMap[4].location == indexMap[4].location);
     REQUIRE(charMap[4].length == indexMap[4].length);
 }
+
+namespace
+{
+    /* Per-byte character index, as built before it was made compact */
+    std::vector<size_t> BuildReferenceIndex(const ByteBuffer& byteBuffer)
+    {
+        std::vector<size_t> index(byteBuffer.length(), 0);
+        size_t pos = 0;
+        size_t charPos = 0;
+
+        while (pos < byteBuffer.length() && byteBuffer[pos]) {
+            unsigned char byte = byteBuffer[pos];
+            size_t charLen = byte < 0x80 ? 1 : byte < 0xC0 ? 1 : byte < 0xE0 ? 2 : byte < 0xF0 ? 3 : 4;
+
+            for (size_t i = pos; i < pos + charLen && i < index.size(); ++i)
+                index[i] = charPos;
+
+            pos += charLen;
+            charPos++;
+        }
+
+        return index;
+    }
+}
+
+TEST_CASE("Compact character index matches per-byte index", "[bytebuffer][sourcemap]")
+{
+    const char* pieces[] = { "a", "\n", "\xc2\xa2", "\xe2\x82\xac", "\xf0\x90\x8d\x88", "\x80", "\xe2\x82" };
+    const size_t piecesCount = sizeof(pieces) / sizeof(pieces[0]);
+
+    unsigned seed = 42;
+    for (int round = 0; round < 200; ++round) {
+        ByteBuffer src;
+
+        // lengths around several 64-byte blocks, ASCII prefix of varying length
+        const size_t asciiPrefix = round % 70;
+        src.append(asciiPrefix, 'x');
+
+        const size_t pieceCount = round % 97;
+        for (size_t i = 0; i < pieceCount; ++i) {
+            seed = seed * 1103515245 + 12345;
+            src += pieces[(seed >> 16) % piecesCount];
+        }
+
+        if (round % 10 == 9)
+            src += std::string("\0tail", 5);
+
+        ByteBufferCharacterIndex index;
+        mdp::BuildCharacterIndex(index, src);
+
+        const std::vector<size_t> reference = BuildReferenceIndex(src);
+
+        REQUIRE(index.size() == reference.size());
+        for (size_t i = 0; i < reference.size(); ++i) {
+            INFO("round " << round << ", byte " << i);
+            REQUIRE(index[i] == reference[i]);
+        }
+    }
+}
+
+TEST_CASE("ASCII character index maps bytes onto characters", "[bytebuffer][sourcemap]")
+{
+    ByteBuffer src(200, 'a');
+    src[150] = '\0';
+
+    ByteBufferCharacterIndex index;
+    mdp::BuildCharacterIndex(index, src);
+
+    REQUIRE(index.size() == 200);
+    REQUIRE(index[0] == 0);
+    REQUIRE(index[149] == 149);
+    REQUIRE(index[150] == 0);
+    REQUIRE(index[199] == 0);
+}
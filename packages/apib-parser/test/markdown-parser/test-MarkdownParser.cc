@@ -753,3 +753,66 @@ TEST_CASE("Empty quota in listitem", "[parser]")
     REQUIRE(list.children()[1].children()[0].children()[0].sourceMap[0].location == 25);
     REQUIRE(list.children()[1].children()[0].children()[0].sourceMap[0].length == 3);
 }
+
+TEST_CASE("Unchanged text references the source", "[parser][text]")
+{
+    MarkdownParser parser;
+    MarkdownNode ast;
+
+    ByteBuffer src
+        = "# Header\n"
+          "\n"
+          "Lorem\n"
+          "\n"
+          "    <code>42</code>\n";
+
+    parser.parse(src, ast);
+
+    REQUIRE(ast.children().size() == 3);
+
+    const char* begin = src.data();
+    const char* end = src.data() + src.length();
+
+    for (MarkdownNodeIterator it = ast.children().begin(); it != ast.children().end(); ++it) {
+        REQUIRE(!it->text.empty());
+        REQUIRE(it->text.data() >= begin);
+        REQUIRE(it->text.data() + it->text.length() <= end);
+    }
+
+    REQUIRE(ast.children()[0].text == "Header");
+    REQUIRE(ast.children()[1].text == "Lorem");
+    REQUIRE(ast.children()[2].text == "<code>42</code>\n");
+}
+
+TEST_CASE("Transformed text is not a source slice", "[parser][text]")
+{
+    MarkdownParser parser;
+    MarkdownNode ast;
+
+    ByteBuffer src
+        = "    Lorem\n"
+          "    Ipsum\n";
+
+    parser.parse(src, ast);
+
+    REQUIRE(ast.children().size() == 1);
+
+    MarkdownNode& node = ast.children().front();
+    REQUIRE(node.type == CodeMarkdownNodeType);
+    REQUIRE(node.text == "Lorem\nIpsum\n");
+    REQUIRE((node.text.data() < src.data() || node.text.data() >= src.data() + src.length()));
+}
+
+TEST_CASE("Moved node re-parents its children", "[parser][node]")
+{
+    MarkdownParser parser;
+    MarkdownNode ast;
+
+    parser.parse("+ A\n", ast);
+
+    MarkdownNode moved(std::move(ast));
+
+    REQUIRE(moved.children().size() == 1);
+    REQUIRE(&moved.children().front().parent() == &moved);
+    REQUIRE(moved.children().front().children().front().text == "A");
+}
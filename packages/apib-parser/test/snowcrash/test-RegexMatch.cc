@@ -35,3 +35,52 @@ TEST_CASE("regexmatch/request-payload", "Match request payload test")
                 "^[Rr]equest([[:space:]]+([A-Za-z0-9_]|[[:space:]])*)?([[:space:]]\\([^\\)]*\\))?$")
         == true);
 }
+
+TEST_CASE("regexmatch/repeated", "Repeated evaluation of one expression")
+{
+    for (int i = 0; i < 3; ++i) {
+        REQUIRE(RegexMatch("GET /resource", "^(GET|HEAD)[[:space:]]+/"));
+        REQUIRE(!RegexMatch("POST /resource", "^(GET|HEAD)[[:space:]]+/"));
+    }
+}
+
+TEST_CASE("regexmatch/invalid", "Invalid expression does not match")
+{
+    REQUIRE(RegexMatch("abc", "(abc") == false);
+    REQUIRE(RegexMatch("abc", "(abc") == false);
+
+    CaptureGroups groups;
+    REQUIRE(RegexCapture("abc", "(abc", groups) == false);
+    REQUIRE(groups.empty());
+}
+
+TEST_CASE("regexcapture/reuse", "Capture groups are overwritten by subsequent capture")
+{
+    const char* const expression = "^([A-Za-z]+)([[:space:]]+([0-9]+))?$";
+
+    CaptureGroups groups;
+    REQUIRE(RegexCapture("Response 200", expression, groups, 4));
+    REQUIRE(groups.size() == 4);
+    REQUIRE(groups[0] == "Response 200");
+    REQUIRE(groups[1] == "Response");
+    REQUIRE(groups[3] == "200");
+
+    REQUIRE(RegexCapture("Request", expression, groups, 4));
+    REQUIRE(groups.size() == 4);
+    REQUIRE(groups[0] == "Request");
+    REQUIRE(groups[1] == "Request");
+    REQUIRE(groups[2].empty());
+    REQUIRE(groups[3].empty());
+
+    REQUIRE(RegexCapture("1 2 3", expression, groups, 4) == false);
+    REQUIRE(groups.empty());
+}
+
+TEST_CASE("regexcapture/large-group-size", "Capture with more groups than expression has")
+{
+    CaptureGroups groups;
+    REQUIRE(RegexCapture("key: value", "^([^:]+):[[:space:]]*(.*)$", groups, 32));
+    REQUIRE(groups.size() >= 3);
+    REQUIRE(groups[1] == "key");
+    REQUIRE(groups[2] == "value");
+}
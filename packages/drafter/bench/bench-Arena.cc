@@ -0,0 +1,138 @@
+//
+//  bench/bench-Arena.cc
+//  drafter
+//
+//  Copyright (c) 2020 Apiary Inc. All rights reserved.
+//
+//  Microbenchmark of building and releasing API Element trees, heap
+//  allocated versus allocated from a refract::Arena; directly and through
+//  drafter_parse_blueprint/drafter_free_result with arena_allocated.
+//
+//  usage: drafter-bench-arena [entries] [resources]
+//
+
+#include "drafter.h"
+#include "refract/Arena.h"
+#include "refract/Element.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using namespace refract;
+
+namespace
+{
+    using clock = std::chrono::steady_clock;
+
+    std::unique_ptr<ArrayElement> sampleTree(std::size_t entries)
+    {
+        auto result = make_element<ArrayElement>();
+        for (std::size_t i = 0; i < entries; ++i) {
+            auto obj = make_element<ObjectElement>(make_element<MemberElement>("id", from_primitive(i)),
+                make_element<MemberElement>("name", from_primitive("Example")),
+                make_element<MemberElement>("tags", make_element<ArrayElement>(from_primitive("a"), from_primitive("b"))));
+            obj->meta().set("id", from_primitive("Sample"));
+            result->get().push_back(std::move(obj));
+        }
+        return result;
+    }
+
+    // resources, each with an action responding with the same named type
+    std::string sampleBlueprint(std::size_t resources)
+    {
+        std::ostringstream s;
+        s << "FORMAT: 1A\n\n# Sample API\n\n";
+        for (std::size_t i = 0; i < resources; ++i) {
+            s << "## Resource " << i << " [/resources/" << i << "/{id}]\n\n"
+              << "+ Parameters\n"
+              << "    + id: 42 (number) - Identifier\n\n"
+              << "### Retrieve Resource " << i << " [GET]\n\n"
+              << "+ Response 200 (application/json)\n"
+              << "    + Attributes (Item)\n\n";
+        }
+        s << "# Data Structures\n\n"
+          << "## Item (object)\n\n"
+          << "+ id: 42 (number, required)\n"
+          << "+ name: Example (string)\n"
+          << "+ tags: a, b (array[string])\n\n";
+        return s.str();
+    }
+
+    double ms(clock::duration d)
+    {
+        return std::chrono::duration<double, std::milli>(d).count();
+    }
+
+    void report(const char* name, clock::duration build, clock::duration teardown)
+    {
+        std::cout << name << ": build " << ms(build) << " ms, teardown " << ms(teardown) << " ms\n";
+    }
+
+    void parse(const char* name, const std::string& source, bool arenaAllocated)
+    {
+        drafter_parse_options* options = drafter_init_parse_options();
+        if (arenaAllocated)
+            drafter_set_arena_allocated(options);
+
+        const auto start = clock::now();
+        drafter_result* result = nullptr;
+        drafter_parse_blueprint(source.c_str(), &result, options);
+        const auto parsed = clock::now();
+        drafter_free_result(result);
+        const auto released = clock::now();
+
+        drafter_free_parse_options(options);
+
+        report(name, parsed - start, released - parsed);
+    }
+} // namespace
+
+int main(int argc, const char* argv[])
+{
+    const std::size_t entries = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+    const std::size_t resources = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1000;
+
+    {
+        const auto start = clock::now();
+        auto tree = sampleTree(entries);
+        const auto built = clock::now();
+        tree.reset();
+        const auto released = clock::now();
+
+        report("heap ", built - start, released - built);
+    }
+
+    {
+        const auto start = clock::now();
+        std::unique_ptr<Arena> arena(new Arena);
+        std::unique_ptr<ArrayElement> tree;
+        {
+            ArenaScope scope(arena.get());
+            tree = sampleTree(entries);
+        }
+        const auto built = clock::now();
+        const std::size_t allocations = arena->allocations();
+        {
+            ArenaScope scope(arena.get());
+            tree.reset();
+        }
+        arena.reset();
+        const auto released = clock::now();
+
+        report("arena", built - start, released - built);
+        std::cout << "arena served " << allocations << " element allocations\n";
+    }
+
+    const std::string source = sampleBlueprint(resources);
+
+    // runs alternate, the first pair also shows warm-up effects
+    parse("parse heap ", source, false);
+    parse("parse arena", source, true);
+    parse("parse heap ", source, false);
+    parse("parse arena", source, true);
+
+    return 0;
+}
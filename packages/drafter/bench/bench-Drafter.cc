@@ -0,0 +1,376 @@
+//
+//  bench/bench-Drafter.cc
+//  drafter
+//
+//  Copyright (c) 2020 Apiary Inc. All rights reserved.
+//
+//  End-to-end benchmark of the parsing pipeline, timing every phase
+//  separately over the test fixtures and synthetically scaled documents.
+//  Results are written as JSON, times are milliseconds per run.
+//
+//  Phases are exclusive of each other: `snowcrash` excludes the markdown
+//  parse it does internally, `registerNamedTypes` and `wrapRefract` exclude
+//  MSON expansion and body/schema generation nested in them.
+//
+//  usage: drafter-bench [-n repeat] [-o output.json] [manifest]
+//
+//  The manifest lists one fixture per line, relative to the fixtures
+//  directory; by default all fixtures found when configuring the build.
+//
+
+#include "snowcrash.h"
+#include "MarkdownParser.h"
+
+#include "ConversionContext.h"
+#include "NamedTypesRegistry.h"
+#include "RefractAPI.h"
+#include "refract/SerializeSo.h"
+#include "utils/so/JsonIo.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace drafter;
+namespace so = drafter::utils::so;
+
+namespace
+{
+    using clock = std::chrono::steady_clock;
+
+    enum Phase
+    {
+        MarkdownPhase = 0,
+        SnowcrashPhase,
+        RegisterNamedTypesPhase,
+        WrapRefractPhase,
+        ExpansionPhase,
+        ValueGenerationPhase,
+        SchemaGenerationPhase,
+        RenderSoPhase,
+        SerializationPhase,
+        PhaseCount
+    };
+
+    const char* const PhaseNames[PhaseCount] = {
+        "markdown",
+        "snowcrash",
+        "registerNamedTypes",
+        "wrapRefract",
+        "expansion",
+        "valueGeneration",
+        "schemaGeneration",
+        "renderSo",
+        "serialization",
+    };
+
+    struct Timings {
+        clock::duration phases[PhaseCount] = {};
+        std::size_t assetHits = 0;   //< generated assets reused, see GeneratedAssets
+        std::size_t assetMisses = 0; //< generated assets generated
+
+        Timings& operator+=(const Timings& other)
+        {
+            for (std::size_t i = 0; i < PhaseCount; ++i)
+                phases[i] += other.phases[i];
+            assetHits += other.assetHits;
+            assetMisses += other.assetMisses;
+            return *this;
+        }
+    };
+
+    struct Document {
+        std::string name;
+        std::string source;
+    };
+
+    clock::duration nestedIn(const PhaseTimings& before, const PhaseTimings& after)
+    {
+        return (after.expansion - before.expansion) + (after.valueGeneration - before.valueGeneration)
+            + (after.schemaGeneration - before.schemaGeneration);
+    }
+
+    clock::duration positive(clock::duration d)
+    {
+        return std::max(d, clock::duration::zero());
+    }
+
+    // Parse the document once, adding up time spent in every phase;
+    // false if the pipeline stopped early on an error
+    bool run(const std::string& source, Timings& timings)
+    {
+        auto start = clock::now();
+        {
+            mdp::MarkdownParser parser;
+            mdp::MarkdownNode ast;
+            parser.parse(source, ast);
+        }
+        const auto markdown = clock::now() - start;
+        timings.phases[MarkdownPhase] += markdown;
+
+        snowcrash::ParseResult<snowcrash::Blueprint> blueprint;
+        start = clock::now();
+        snowcrash::parse(source, snowcrash::ExportSourcemapOption, blueprint);
+        timings.phases[SnowcrashPhase] += positive(clock::now() - start - markdown);
+
+        if (blueprint.report.error.code != snowcrash::Error::OK)
+            return false;
+
+        PhaseTimings nested;
+        std::unique_ptr<refract::IElement> result;
+
+        try {
+            start = clock::now();
+            ConversionContext context(source.c_str());
+            context.collectTimings(&nested);
+            const auto contextCreated = clock::now();
+
+            PhaseTimings before = nested;
+            RegisterNamedTypes(
+                MakeNodeInfo(blueprint.node.content.elements(), blueprint.sourceMap.content.elements()), context);
+            const auto registered = clock::now();
+            timings.phases[RegisterNamedTypesPhase]
+                += positive(registered - contextCreated - nestedIn(before, nested));
+
+            before = nested;
+            result = BlueprintToRefract(MakeNodeInfo(blueprint.node, blueprint.sourceMap), context);
+            timings.phases[WrapRefractPhase]
+                += positive((contextCreated - start) + (clock::now() - registered) - nestedIn(before, nested));
+
+            timings.assetHits += context.generatedAssets().hits();
+            timings.assetMisses += context.generatedAssets().misses();
+        } catch (const std::exception&) {
+        } catch (const snowcrash::Error&) {
+        }
+
+        timings.phases[ExpansionPhase] += nested.expansion;
+        timings.phases[ValueGenerationPhase] += nested.valueGeneration;
+        timings.phases[SchemaGenerationPhase] += nested.schemaGeneration;
+
+        if (!result)
+            return false;
+
+        start = clock::now();
+        auto soValue = refract::serialize::renderSo(*result, false);
+        timings.phases[RenderSoPhase] += clock::now() - start;
+
+        std::ostringstream out;
+        start = clock::now();
+        so::serialize_json(out, soValue);
+        timings.phases[SerializationPhase] += clock::now() - start;
+
+        return true;
+    }
+
+    //
+    // Synthetic documents
+    //
+
+    const char* const SyntheticHeader = "FORMAT: 1A\n\n# Synthetic API\n\n";
+
+    // resources, each with an action responding with the same named type
+    std::string syntheticResources(std::size_t resources)
+    {
+        std::ostringstream s;
+        s << SyntheticHeader;
+        s << "## Group Resources\n\n";
+        for (std::size_t i = 0; i < resources; ++i) {
+            s << "## Resource " << i << " [/resources/" << i << "/{id}]\n\n"
+              << "+ Parameters\n"
+              << "    + id: 42 (number) - Identifier\n\n"
+              << "### Retrieve Resource " << i << " [GET]\n\n"
+              << "+ Response 200 (application/json)\n"
+              << "    + Attributes (Item)\n\n";
+        }
+        s << "# Data Structures\n\n"
+          << "## Item (object)\n\n"
+          << "+ id: 42 (number, required)\n"
+          << "+ name: Example (string)\n"
+          << "+ tags: a, b (array[string])\n\n";
+        return s.str();
+    }
+
+    // named types, all referred from a single response
+    std::string syntheticNamedTypes(std::size_t types)
+    {
+        std::ostringstream s;
+        s << SyntheticHeader;
+        s << "## Catalogue [/catalogue]\n\n"
+          << "### Retrieve Catalogue [GET]\n\n"
+          << "+ Response 200 (application/json)\n"
+          << "    + Attributes\n";
+        for (std::size_t i = 0; i < types; ++i)
+            s << "        + item" << i << " (Type" << i << ")\n";
+        s << "\n# Data Structures\n\n";
+        for (std::size_t i = 0; i < types; ++i) {
+            s << "## Type" << i << " (object)\n\n"
+              << "+ id: " << i << " (number, required)\n"
+              << "+ name: Type " << i << " (string)\n"
+              << "+ kind (enum)\n"
+              << "    + first\n"
+              << "    + second\n\n";
+        }
+        return s.str();
+    }
+
+    // chain of named types, each inheriting from the previous one
+    std::string syntheticInheritance(std::size_t depth)
+    {
+        std::ostringstream s;
+        s << SyntheticHeader;
+        s << "## Leaf [/leaf]\n\n"
+          << "### Retrieve Leaf [GET]\n\n"
+          << "+ Response 200 (application/json)\n"
+          << "    + Attributes (Level" << (depth ? depth - 1 : 0) << ")\n\n";
+        s << "# Data Structures\n\n"
+          << "## Level0 (object)\n\n"
+          << "+ level0: 0 (number)\n\n";
+        for (std::size_t i = 1; i < depth; ++i) {
+            s << "## Level" << i << " (Level" << i - 1 << ")\n\n"
+              << "+ level" << i << ": " << i << " (number)\n\n";
+        }
+        return s.str();
+    }
+
+    //
+    // Input & output
+    //
+
+    bool readFile(const std::string& path, std::string& content)
+    {
+        std::ifstream in(path.c_str(), std::ios::binary);
+        if (!in)
+            return false;
+
+        std::ostringstream s;
+        s << in.rdbuf();
+        content = s.str();
+        return true;
+    }
+
+    bool readFixtures(const std::string& manifest, std::vector<Document>& documents)
+    {
+        std::ifstream in(manifest.c_str());
+        if (!in) {
+            std::cerr << "drafter-bench: unable to read manifest '" << manifest << "'\n";
+            return false;
+        }
+
+        std::string line;
+        while (std::getline(in, line)) {
+            if (line.empty())
+                continue;
+
+            Document document;
+            document.name = line;
+            if (!readFile(DRAFTER_BENCH_FIXTURES_DIR + line, document.source)) {
+                std::cerr << "drafter-bench: unable to read fixture '" << line << "'\n";
+                return false;
+            }
+            documents.push_back(std::move(document));
+        }
+
+        return true;
+    }
+
+    so::Number milliseconds(clock::duration d, std::size_t repeat)
+    {
+        char buffer[32];
+        std::snprintf(
+            buffer, sizeof(buffer), "%.4f", std::chrono::duration<double, std::milli>(d).count() / repeat);
+        return so::Number(std::string(buffer));
+    }
+
+    so::Object phasesToSo(const Timings& timings, std::size_t repeat)
+    {
+        so::Object result;
+        clock::duration total = clock::duration::zero();
+        for (std::size_t i = 0; i < PhaseCount; ++i) {
+            result.data.emplace_back(PhaseNames[i], milliseconds(timings.phases[i], repeat));
+            total += timings.phases[i];
+        }
+        result.data.emplace_back("total", milliseconds(total, repeat));
+        return result;
+    }
+
+    so::Object assetsToSo(const Timings& timings)
+    {
+        so::Object result;
+        result.data.emplace_back("hits", so::Number(timings.assetHits));
+        result.data.emplace_back("misses", so::Number(timings.assetMisses));
+        return result;
+    }
+} // namespace
+
+int main(int argc, const char* argv[])
+{
+    std::size_t repeat = 5;
+    std::string output;
+    std::string manifest = DRAFTER_BENCH_FIXTURES;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+            repeat = std::max<std::size_t>(1, std::strtoul(argv[++i], nullptr, 10));
+        else if (std::strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+            output = argv[++i];
+        else
+            manifest = argv[i];
+    }
+
+    std::vector<Document> documents;
+    if (!readFixtures(manifest, documents))
+        return EXIT_FAILURE;
+
+    documents.push_back({ "synthetic/resources-500", syntheticResources(500) });
+    documents.push_back({ "synthetic/named-types-500", syntheticNamedTypes(500) });
+    documents.push_back({ "synthetic/inheritance-100", syntheticInheritance(100) });
+
+    so::Array results;
+    Timings totals;
+
+    for (const auto& document : documents) {
+        Timings timings;
+        bool ok = true;
+        for (std::size_t i = 0; i < repeat; ++i)
+            ok = run(document.source, timings) && ok;
+
+        totals += timings;
+
+        so::Object result;
+        result.data.emplace_back("name", so::String(document.name));
+        result.data.emplace_back("bytes", so::Number(document.source.size()));
+        result.data.emplace_back("ok", ok ? so::Value(so::True{}) : so::Value(so::False{}));
+        result.data.emplace_back("phases", phasesToSo(timings, repeat));
+        result.data.emplace_back("assetCache", assetsToSo(timings));
+        results.data.emplace_back(std::move(result));
+    }
+
+    so::Object report;
+    report.data.emplace_back("unit", so::String("ms"));
+    report.data.emplace_back("repeat", so::Number(repeat));
+    report.data.emplace_back("documents", std::move(results));
+    report.data.emplace_back("totals", phasesToSo(totals, repeat));
+    report.data.emplace_back("assetCache", assetsToSo(totals));
+
+    if (output.empty()) {
+        so::serialize_json(std::cout, report);
+        std::cout << std::endl;
+    } else {
+        std::ofstream out(output.c_str());
+        so::serialize_json(out, report);
+        out << std::endl;
+        if (!out) {
+            std::cerr << "drafter-bench: unable to write '" << output << "'\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,143 @@
+//
+//  bench/bench-Escape.cc
+//  drafter
+//
+//  Copyright (c) 2020 Apiary Inc. All rights reserved.
+//
+//  Microbenchmark of JSON/YAML string escaping. Compares the bulk escaping
+//  engine in utils/so/Escape.cc with byte-by-byte escaping through an
+//  std::ostream_iterator.
+//
+//  usage: drafter-bench-escape [megabytes]
+//
+
+#include "utils/so/Escape.h"
+#include "utils/so/OutputBuffer.h"
+#include "utils/Utf8.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+
+using namespace drafter::utils;
+
+namespace
+{
+    // escaping as done before the bulk engine, kept here as a baseline
+    template <typename It>
+    It bytewise_json(const std::string& str, It out)
+    {
+        for (char byte : str) {
+            switch (byte) {
+                case '"':
+                case '\\':
+                    *out++ = '\\';
+                    *out++ = byte;
+                    break;
+                case '\n':
+                    *out++ = '\\';
+                    *out++ = 'n';
+                    break;
+                case '\t':
+                    *out++ = '\\';
+                    *out++ = 't';
+                    break;
+                default:
+                    if (static_cast<unsigned char>(byte) > 0x1f) {
+                        *out++ = byte;
+                    } else {
+                        char u_sym_buf[7];
+                        std::snprintf(u_sym_buf, 7, "\\u%04x", byte);
+                        out = std::copy(u_sym_buf, u_sym_buf + 6, out);
+                    }
+            }
+        }
+        return out;
+    }
+
+    template <typename It>
+    It codepointwise_yaml(const std::string& str, It out)
+    {
+        utf8::input_iterator<std::string::const_iterator> p{ str.begin(), str.end() };
+        const utf8::input_iterator<std::string::const_iterator> end{ str.end(), str.end() };
+
+        for (; p != end; ++p) {
+            const utf8::codepoint c = *p;
+            if (c == '"' || c == '\\') {
+                *out++ = '\\';
+                *out++ = static_cast<char>(c);
+            } else if (c == '\n') {
+                *out++ = '\\';
+                *out++ = 'n';
+            } else {
+                out = utf8::encode(c, out);
+            }
+        }
+        return out;
+    }
+
+    // Text resembling message bodies and descriptions: long printable runs,
+    // some quoting, line breaks and occasional non-ASCII characters
+    std::string corpus(std::size_t size)
+    {
+        const std::string chunks[] = { //
+            "{\n  \"id\": 1234,\n  \"name\": \"Example resource\",\n",
+            "  \"description\": \"Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor\",\n",
+            "Retrieves the state of a single resource; see the section on pagination for details.\n",
+            "  \"url\": \"https://api.example.com/v1/resources/1234?expand=owner\"\n}\n",
+            "Příliš žluťoučký kůň úpěl ďábelské ódy.\n" };
+
+        std::string result;
+        result.reserve(size);
+        for (std::size_t i = 0; result.size() < size; ++i)
+            result += chunks[i % (sizeof(chunks) / sizeof(chunks[0]))];
+        return result;
+    }
+
+    template <typename F>
+    double measure(const char* name, std::size_t bytes, F f)
+    {
+        std::ostringstream out;
+
+        const auto start = std::chrono::steady_clock::now();
+        f(out);
+        const auto end = std::chrono::steady_clock::now();
+
+        const double seconds = std::chrono::duration<double>(end - start).count();
+        const double throughput = bytes / seconds / (1024 * 1024);
+
+        std::cout << name << ": " << throughput << " MiB/s (" << out.str().size() << " bytes out)\n";
+        return throughput;
+    }
+} // namespace
+
+int main(int argc, const char* argv[])
+{
+    const std::size_t megabytes = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 64;
+    const std::string input = corpus(megabytes * 1024 * 1024);
+
+    const double jsonBefore = measure("json byte-wise", input.size(), [&input](std::ostream& out) {
+        bytewise_json(input, std::ostream_iterator<char>(out));
+    });
+    const double jsonAfter = measure("json bulk     ", input.size(), [&input](std::ostream& out) {
+        so::output_buffer buffer(out);
+        so::escape_json(buffer, input);
+    });
+
+    const double yamlBefore = measure("yaml per-codepoint", input.size(), [&input](std::ostream& out) {
+        codepointwise_yaml(input, std::ostream_iterator<char>(out));
+    });
+    const double yamlAfter = measure("yaml bulk         ", input.size(), [&input](std::ostream& out) {
+        so::output_buffer buffer(out);
+        so::escape_yaml(buffer, input);
+    });
+
+    std::cout << "json speedup: " << jsonAfter / jsonBefore << "x\n";
+    std::cout << "yaml speedup: " << yamlAfter / yamlBefore << "x\n";
+
+    return 0;
+}
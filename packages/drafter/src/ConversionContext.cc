@@ -10,29 +10,118 @@
 
 #include "snowcrash.h"
 
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
 using namespace drafter;
 
+namespace
+{
+    void HashCombine(std::size_t& seed, std::size_t value) noexcept
+    {
+        seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+
+    std::size_t HashOf(const snowcrash::Warning& warning)
+    {
+        std::size_t seed = std::hash<std::string>{}(warning.message);
+        HashCombine(seed, std::hash<int>{}(warning.code));
+
+        for (const auto& range : warning.location) {
+            HashCombine(seed, range.location);
+            HashCombine(seed, range.length);
+        }
+
+        return seed;
+    }
+
+    bool Equal(const snowcrash::Warning& lhs, const snowcrash::Warning& rhs)
+    {
+        if (lhs.code != rhs.code || lhs.location.size() != rhs.location.size() || lhs.message != rhs.message) {
+            return false;
+        }
+
+        return std::equal(lhs.location.begin(),
+            lhs.location.end(),
+            rhs.location.begin(),
+            [](const mdp::CharactersRange& l, const mdp::CharactersRange& r) {
+                return l.location == r.location && l.length == r.length;
+            });
+    }
+}
+
 ConversionContext::ConversionContext(const char* src, const drafter_parse_options* opts, bool expandMson) noexcept
-    : newline_indices_(GetLinesEndIndex(src)),
+    : source_(src),
+      newline_indices_built_{},
+      newline_indices_{},
       expand_mson_{ expandMson },
       options_{ opts },
       registry_{},
-      warnings_{}
+      types_{ &registry_ },
+      expanded_types_{},
+      generated_assets_{},
+      warnings_{},
+      warnings_index_{}
+{
+}
+
+ConversionContext::ConversionContext(const ConversionContext& parent, PhaseTimings* timings) noexcept
+    : source_(parent.source_),
+      parent_(&parent),
+      newline_indices_built_{},
+      newline_indices_{},
+      expand_mson_{ parent.expand_mson_ },
+      options_{ parent.options_ },
+      registry_{},
+      types_{ parent.types_ },
+      expanded_types_{},
+      generated_assets_{},
+      warnings_{},
+      warnings_index_{},
+      timings_{ timings }
 {
 }
 
+bool ConversionContext::isFork() const noexcept
+{
+    return parent_ != nullptr;
+}
+
 refract::Registry& ConversionContext::typeRegistry() noexcept
 {
-    return registry_;
+    return *types_;
 }
 
 const refract::Registry& ConversionContext::typeRegistry() const noexcept
 {
-    return registry_;
+    return *types_;
+}
+
+refract::ExpandedTypes& ConversionContext::expandedTypes() noexcept
+{
+    return expanded_types_;
+}
+
+GeneratedAssets& ConversionContext::generatedAssets() noexcept
+{
+    return generated_assets_;
+}
+
+const GeneratedAssets& ConversionContext::generatedAssets() const noexcept
+{
+    return generated_assets_;
 }
 
-const NewLinesIndex& ConversionContext::newlineIndices() const noexcept
+const NewLinesIndex& ConversionContext::newlineIndices() const
 {
+    if (parent_) {
+        return parent_->newlineIndices();
+    }
+
+    std::call_once(newline_indices_built_, [this]() {
+        newline_indices_ = GetLinesEndIndex(source_, source_ ? std::strlen(source_) : 0);
+    });
     return newline_indices_;
 }
 
@@ -43,30 +132,28 @@ bool ConversionContext::expandMson() const noexcept
 
 void ConversionContext::warn(const snowcrash::Warning& warning)
 {
-    for (auto& item : warnings_) {
-        bool equalSourceMap = true;
-
-        // Compare sourcemap
-        if (item.location.size() == warning.location.size()) {
-            for (size_t i = 0; i < item.location.size(); i++) {
-                if (item.location.at(i).length != warning.location.at(i).length
-                    || item.location.at(i).location != warning.location.at(i).location) {
-
-                    equalSourceMap = false;
-                }
-            }
-        } else {
-            equalSourceMap = false;
-        }
+    const std::size_t hash = HashOf(warning);
 
-        if (equalSourceMap && item.code == warning.code && item.message == warning.message) {
+    auto candidates = warnings_index_.equal_range(hash);
+    for (auto it = candidates.first; it != candidates.second; ++it) {
+        if (Equal(warnings_[it->second], warning)) {
             return;
         }
     }
 
+    warnings_index_.emplace(hash, warnings_.size());
     warnings_.push_back(warning);
 }
 
+void ConversionContext::merge(const ConversionContext& fork)
+{
+    for (const auto& warning : fork.warnings_) {
+        warn(warning);
+    }
+
+    generated_assets_.count(fork.generated_assets_);
+}
+
 const ConversionContext::Warnings& ConversionContext::warnings() const noexcept
 {
     return warnings_;
@@ -76,3 +163,13 @@ const drafter_parse_options* ConversionContext::options() const noexcept
 {
     return options_;
 }
+
+void ConversionContext::collectTimings(PhaseTimings* timings) noexcept
+{
+    timings_ = timings;
+}
+
+PhaseTimings* ConversionContext::timings() const noexcept
+{
+    return timings_;
+}
@@ -9,9 +9,14 @@
 #define DRAFTER_CONVERSIONCONTEXT_H
 
 #include <boost/container/vector.hpp>
+#include <mutex>
+#include <unordered_map>
 
 #include "refract/Registry.h"
+#include "refract/ExpandVisitor.h"
+#include "GeneratedAssets.h"
 #include "SourceMapUtils.h"
+#include "PhaseTimings.h"
 #include "options.h"
 
 namespace snowcrash
@@ -27,31 +32,81 @@ namespace drafter
         using Warnings = boost::container::vector<snowcrash::SourceAnnotation>;
 
     private:
-        const NewLinesIndex newline_indices_;
+        const char* const source_;
+        const ConversionContext* const parent_ = nullptr;
+
+        mutable std::once_flag newline_indices_built_;
+        mutable NewLinesIndex newline_indices_;
+
         const bool expand_mson_;
         const drafter_parse_options* const options_;
 
         refract::Registry registry_;
+        refract::Registry* const types_; //< registry_, or the one of the parent in a fork
+        refract::ExpandedTypes expanded_types_;
+        GeneratedAssets generated_assets_;
         Warnings warnings_;
+        std::unordered_multimap<std::size_t, std::size_t> warnings_index_; //< warning hash -> position in warnings_
+
+        PhaseTimings* timings_ = nullptr;
 
     public:
+        /// @remark the source is referenced, it must outlive the context
         explicit ConversionContext( //
             const char*,
             const drafter_parse_options* opts = nullptr,
             bool expandMson = false // TODO avoid, only used in unit tests
             ) noexcept;
 
-        const NewLinesIndex& newlineIndices() const noexcept;
+        ///
+        /// Fork a context for converting a part of the document on another thread
+        ///
+        /// The fork shares source, options and the type registry of the
+        /// parent, which must neither change nor go away while the fork is in
+        /// use. Warnings and the expanded types and generated assets caches
+        /// are its own; warnings are handed back by the caller, see merge().
+        ///
+        /// @param parent   context to fork
+        /// @param timings  where to accumulate phase timings of the fork,
+        ///                 nullptr collects nothing
+        ///
+        ConversionContext(const ConversionContext& parent, PhaseTimings* timings) noexcept;
+
+        ConversionContext(const ConversionContext&) = delete;
+        ConversionContext& operator=(const ConversionContext&) = delete;
+
+        /// Whether this context has been forked from another one
+        bool isFork() const noexcept;
+
+        /// Add warnings and asset cache counters of a fork, as if they were
+        /// added to this context
+        void merge(const ConversionContext& fork);
+
+        /// Offsets of line ends in the source, built on first use
+        const NewLinesIndex& newlineIndices() const;
 
         bool expandMson() const noexcept;
 
         refract::Registry& typeRegistry() noexcept;
         const refract::Registry& typeRegistry() const noexcept;
 
+        refract::ExpandedTypes& expandedTypes() noexcept;
+
+        GeneratedAssets& generatedAssets() noexcept;
+        const GeneratedAssets& generatedAssets() const noexcept;
+
+        /// Warnings in order of first occurrence
         const Warnings& warnings() const noexcept;
+
+        /// Add a warning, unless an equal one has been added before
         void warn(const snowcrash::Warning& warning);
 
         const drafter_parse_options* options() const noexcept;
+
+        /// Accumulate time spent in conversion phases into timings,
+        /// nullptr (the default) collects nothing
+        void collectTimings(PhaseTimings* timings) noexcept;
+        PhaseTimings* timings() const noexcept;
     };
 }
 #endif
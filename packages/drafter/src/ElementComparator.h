@@ -42,7 +42,7 @@ namespace drafter
                     res.end());
 
                 std::sort(res.begin(), res.end(), [](const InfoRef::value_type& l, const InfoRef::value_type& r) {
-                    return l.get().first < r.get().first;
+                    return l.get().first.str() < r.get().first.str();
                 });
 
                 return res;
@@ -0,0 +1,281 @@
+//
+//  GeneratedAssets.cc
+//  drafter
+//
+//  Copyright (c) 2020 Apiary Inc. All rights reserved.
+//
+
+#include "GeneratedAssets.h"
+
+#include "refract/Element.h"
+#include "refract/ElementUtils.h"
+#include "refract/Utils.h"
+#include "utils/so/Value.h"
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+
+using namespace drafter;
+using namespace refract;
+
+namespace
+{
+    // Source maps do not take part in generated assets
+    bool isSkipped(const Symbol& name) noexcept
+    {
+        return name == "sourceMap";
+    }
+
+    std::size_t combine(std::size_t seed, std::size_t value) noexcept
+    {
+        return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+    }
+
+    std::size_t hashOf(const IElement& e);
+    bool isSame(const IElement& lhs, const IElement& rhs);
+
+    std::size_t hashOf(const IElement* e)
+    {
+        return e ? hashOf(*e) : 0;
+    }
+
+    bool isSame(const IElement* lhs, const IElement* rhs)
+    {
+        return (lhs && rhs) ? isSame(*lhs, *rhs) : (lhs == rhs);
+    }
+
+    std::size_t hashOf(const InfoElements& info)
+    {
+        std::size_t result = 0;
+        for (const auto& entry : info)
+            if (!isSkipped(entry.first))
+                result = combine(combine(result, std::hash<Symbol>{}(entry.first)), hashOf(*entry.second));
+        return result;
+    }
+
+    bool isSame(const InfoElements& lhs, const InfoElements& rhs)
+    {
+        auto l = lhs.begin();
+        auto r = rhs.begin();
+
+        for (;; ++l, ++r) {
+            while (l != lhs.end() && isSkipped(l->first))
+                ++l;
+            while (r != rhs.end() && isSkipped(r->first))
+                ++r;
+
+            if (l == lhs.end() || r == rhs.end())
+                return l == lhs.end() && r == rhs.end();
+
+            if (l->first != r->first || !isSame(*l->second, *r->second))
+                return false;
+        }
+    }
+
+    // Values of data structure elements
+
+    std::size_t hashValue(const dsd::String& v)
+    {
+        return std::hash<std::string>{}(v.get());
+    }
+
+    std::size_t hashValue(const dsd::Number& v)
+    {
+        // numbers equal across representations, see so::operator==(Number, Number)
+        return std::hash<std::string>{}(drafter::utils::so::to_string(v.native()));
+    }
+
+    std::size_t hashValue(const dsd::Boolean& v)
+    {
+        return v.get() ? 1 : 2;
+    }
+
+    std::size_t hashValue(const dsd::Null&)
+    {
+        return 0;
+    }
+
+    std::size_t hashValue(const dsd::Ref& v)
+    {
+        return std::hash<std::string>{}(v.symbol());
+    }
+
+    std::size_t hashValue(const dsd::Member& v)
+    {
+        return combine(hashOf(v.key()), hashOf(v.value()));
+    }
+
+    std::size_t hashValue(const dsd::Enum& v)
+    {
+        return hashOf(v.value());
+    }
+
+    std::size_t hashValue(const dsd::Holder& v)
+    {
+        return hashOf(v.data());
+    }
+
+    std::size_t hashValue(const dsd::SourceMap&)
+    {
+        return 0;
+    }
+
+    template <typename V>
+    std::size_t hashValue(const V& v)
+    {
+        std::size_t result = v.size();
+        for (const auto& item : v)
+            result = combine(result, hashOf(item.get()));
+        return result;
+    }
+
+    bool isSameValue(const dsd::Member& lhs, const dsd::Member& rhs)
+    {
+        return isSame(lhs.key(), rhs.key()) && isSame(lhs.value(), rhs.value());
+    }
+
+    bool isSameValue(const dsd::Enum& lhs, const dsd::Enum& rhs)
+    {
+        return isSame(lhs.value(), rhs.value());
+    }
+
+    bool isSameValue(const dsd::Holder& lhs, const dsd::Holder& rhs)
+    {
+        return isSame(lhs.data(), rhs.data());
+    }
+
+    bool isSameValue(const dsd::SourceMap&, const dsd::SourceMap&)
+    {
+        return true;
+    }
+
+    template <typename V>
+    bool isSameValue(const V& lhs, const V& rhs, std::true_type /* iterable */)
+    {
+        using value_type = typename V::value_type;
+
+        return lhs.size() == rhs.size()
+            && std::equal(lhs.begin(), lhs.end(), rhs.begin(), [](const value_type& l, const value_type& r) {
+                   return isSame(l.get(), r.get());
+               });
+    }
+
+    template <typename V>
+    bool isSameValue(const V& lhs, const V& rhs, std::false_type /* iterable */)
+    {
+        return lhs == rhs;
+    }
+
+    template <typename V>
+    bool isSameValue(const V& lhs, const V& rhs)
+    {
+        return isSameValue(lhs, rhs, dsd::is_iterable<V>{});
+    }
+
+    struct HashVisitor {
+        template <typename ElementT>
+        std::size_t operator()(const ElementT& e)
+        {
+            std::size_t result = combine(static_cast<std::size_t>(e.type()), std::hash<Symbol>{}(e.element()));
+            result = combine(result, hashOf(e.meta()));
+            result = combine(result, hashOf(e.attributes()));
+            return e.empty() ? result : combine(result, hashValue(e.get()));
+        }
+    };
+
+    struct SameVisitor {
+        const IElement& rhs;
+
+        template <typename ElementT>
+        bool operator()(const ElementT& lhs)
+        {
+            const auto* other = get<const ElementT>(&rhs);
+            return other                                        //
+                && lhs.element() == other->element()            //
+                && lhs.empty() == other->empty()                //
+                && isSame(lhs.meta(), other->meta())            //
+                && isSame(lhs.attributes(), other->attributes()) //
+                && (lhs.empty() || isSameValue(lhs.get(), other->get()));
+        }
+    };
+
+    std::size_t hashOf(const IElement& e)
+    {
+        return visit(e, HashVisitor{});
+    }
+
+    bool isSame(const IElement& lhs, const IElement& rhs)
+    {
+        return visit(lhs, SameVisitor{ rhs });
+    }
+} // namespace
+
+GeneratedAssets::Key GeneratedAssets::keyOf(const IElement& expanded)
+{
+    return Key{ hashOf(expanded), &expanded };
+}
+
+GeneratedAssets::Entry* GeneratedAssets::entryOf(const Key& key)
+{
+    assert(key.source);
+
+    auto range = entries_.equal_range(key.hash);
+
+    for (auto it = range.first; it != range.second; ++it)
+        if (isSame(*it->second.source, *key.source))
+            return &it->second;
+
+    return nullptr;
+}
+
+const std::string* GeneratedAssets::find(Kind kind, const Key& key)
+{
+    assert(kind < KindCount);
+
+    Entry* entry = entryOf(key);
+
+    if (!entry || !entry->generated.test(kind)) {
+        ++misses_;
+        return nullptr;
+    }
+
+    ++hits_;
+    return &entry->assets[kind];
+}
+
+const std::string& GeneratedAssets::add(Kind kind, const Key& key, std::string asset)
+{
+    assert(kind < KindCount);
+
+    Entry* entry = entryOf(key);
+
+    if (!entry) {
+        auto it = entries_.emplace(key.hash, Entry{});
+        entry = &it->second;
+        entry->source = key.source->clone();
+    }
+
+    if (!entry->generated.test(kind)) {
+        entry->assets[kind] = std::move(asset);
+        entry->generated.set(kind);
+    }
+
+    return entry->assets[kind];
+}
+
+void GeneratedAssets::count(const GeneratedAssets& other) noexcept
+{
+    hits_ += other.hits_;
+    misses_ += other.misses_;
+}
+
+std::size_t GeneratedAssets::hits() const noexcept
+{
+    return hits_;
+}
+
+std::size_t GeneratedAssets::misses() const noexcept
+{
+    return misses_;
+}
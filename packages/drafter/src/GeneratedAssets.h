@@ -0,0 +1,89 @@
+//
+//  GeneratedAssets.h
+//  drafter
+//
+//  Copyright (c) 2020 Apiary Inc. All rights reserved.
+//
+
+#ifndef DRAFTER_GENERATEDASSETS_H
+#define DRAFTER_GENERATEDASSETS_H
+
+#include <bitset>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "refract/ElementIfc.h"
+
+namespace drafter
+{
+    ///
+    /// Memoized message bodies and JSON Schemas generated from MSON
+    ///
+    /// Assets are keyed by the content of the expanded data structure they
+    /// are generated from, source maps left out, so payloads sharing the
+    /// same Attributes generate and serialize their assets just once. Lookups
+    /// go by a structural hash, confirmed against a clone of the data
+    /// structure the assets were generated from.
+    ///
+    class GeneratedAssets
+    {
+    public:
+        enum Kind
+        {
+            Body = 0,
+            Schema,
+            KindCount
+        };
+
+        ///
+        /// Key of assets generated from an expanded data structure
+        ///
+        struct Key {
+            std::size_t hash;
+            const refract::IElement* source; //< referenced, must outlive the Key
+        };
+
+    private:
+        struct Entry {
+            std::unique_ptr<refract::IElement> source; //< clone of the data structure
+            std::string assets[KindCount];
+            std::bitset<KindCount> generated;
+        };
+
+        std::unordered_multimap<std::size_t, Entry> entries_;
+        std::size_t hits_ = 0;
+        std::size_t misses_ = 0;
+
+        Entry* entryOf(const Key& key);
+
+    public:
+        ///
+        /// Compute the key of assets generated from an expanded data structure
+        ///
+        static Key keyOf(const refract::IElement& expanded);
+
+        ///
+        /// Query an asset generated before
+        ///
+        /// @returns the asset or nullptr if none has been added under the key
+        ///
+        const std::string* find(Kind kind, const Key& key);
+
+        ///
+        /// Add a generated asset
+        ///
+        /// @returns the added asset
+        ///
+        const std::string& add(Kind kind, const Key& key, std::string asset);
+
+        /// Count hits and misses of another cache, see ConversionContext::merge
+        void count(const GeneratedAssets& other) noexcept;
+
+        std::size_t hits() const noexcept;
+        std::size_t misses() const noexcept;
+    };
+}
+
+#endif
@@ -24,10 +24,7 @@ namespace
     // OPTIM @tjanc@ suspicious switch after visit
     mson::BaseTypeName NamedTypeFromElement(const IElement& element)
     {
-        TypeQueryVisitor type;
-        Visit(type, element);
-
-        switch (type.get()) {
+        switch (TypeQueryVisitor::of(element)) {
             case TypeQueryVisitor::Boolean:
                 return mson::BooleanTypeName;
 
@@ -1,9 +1,12 @@
 #include "NamedTypesRegistry.h"
 
 #include <algorithm>
+#include <cassert>
+#include <limits>
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "Blueprint.h"
 #include "ConversionContext.h"
@@ -207,30 +210,6 @@ namespace
         return collectMembers(ds->sections);
     }
 
-    Members collectMembers(const std::string& id, const MembersMap& members, Members& resolved)
-    {
-        Members collected;
-
-        if (resolved.find(id) != resolved.end()) {
-            return collected;
-        }
-
-        resolved.insert(id);
-
-        MembersMap::const_iterator member = members.find(id);
-        if (member == members.end()) {
-            return collected;
-        }
-
-        for (Members::const_iterator i = member->second.begin(); i != member->second.end(); ++i) {
-            Members sub = collectMembers(*i, members, resolved);
-            collected.insert(*i);
-            collected.insert(sub.begin(), sub.end());
-        }
-
-        return collected;
-    }
-
     struct DependencyTypeInfo {
 
         typedef std::map<std::string, std::string> InheritanceMap;
@@ -268,66 +247,23 @@ namespace
                 }
             }
 
-            // Map members
-            MembersMap members;
+            // Map direct members
             for (DataStructures::const_iterator i = elements.begin(); i != elements.end(); ++i) {
-                members[name(i->node)] = collectMembers(i->node);
-            }
-
-            // Map members into deep
-            for (MembersMap::const_iterator i = members.begin(); i != members.end(); ++i) {
-                Members resolved;
-                objectToMembers[i->first] = collectMembers(i->first, members, resolved);
+                objectToMembers[name(i->node)] = collectMembers(i->node);
             }
 
 #ifdef DEBUG_DEPENDENCIES
             // debug out members
             for (MembersMap::const_iterator i = objectToMembers.begin(); i != objectToMembers.end(); ++i) {
                 std::cout << "Members: " << i->first << std::endl;
-                for (Members::const_iterator it = objectToMembers[i->first].begin();
-                     it != objectToMembers[i->first].end();
-                     ++it) {
+                for (Members::const_iterator it = i->second.begin(); it != i->second.end(); ++it) {
                     std::cout << " - " << *it << std::endl;
                 }
             }
 #endif /* DEBUG_DEPENDENCIES */
         }
 
-        bool hasMember(const snowcrash::DataStructure* object, const snowcrash::DataStructure* member) const
-        {
-            MembersMap::const_iterator members = objectToMembers.find(name(object));
-            if (members == objectToMembers.end()) {
-                return false;
-            }
-
-            return members->second.find(name(member)) != members->second.end();
-        }
-
-        bool hasAncestor(const snowcrash::DataStructure* object, const snowcrash::DataStructure* ancestor) const
-        {
-            std::vector<std::string> symbols;
-
-            const std::string& object_typename = name(object);
-            const std::string& ancestor_typename = name(ancestor);
-
-            auto current_typename = object_typename;
-
-            while (true) {
-                if (current_typename == ancestor_typename)
-                    return true; // found ancestor (happy path)
-                auto next_typename = childToParent.find(current_typename);
-                if (next_typename == childToParent.end())
-                    return false; // arrived at the end
-
-                if (symbols.end() != std::find(symbols.begin(), symbols.end(), current_typename))
-                    return false; // circular reference
-                symbols.emplace_back(current_typename);
-                current_typename = next_typename->second;
-            }
-
-            return false;
-        }
-
+        // Returns base type a data structure is declared with
         mson::BaseTypeName GetType(const snowcrash::DataStructure* ds) const
         {
             return ds->typeDefinition.typeSpecification.name.base;
@@ -361,37 +297,209 @@ namespace
         }
     };
 
-    struct InheritanceComparator {
+    DataStructures SortDataStructures(const DataStructures& found, const DependencyTypeInfo& typeInfo)
+    {
+        std::vector<std::string> names;
+        std::vector<std::vector<std::string> > dependencies;
+
+        names.reserve(found.size());
+        dependencies.reserve(found.size());
+
+        for (const auto& ds : found) {
+            names.push_back(name(ds.node));
+            dependencies.emplace_back();
 
-        const DependencyTypeInfo& typeInfo;
+            DependencyTypeInfo::InheritanceMap::const_iterator parent = typeInfo.childToParent.find(names.back());
+            if (parent != typeInfo.childToParent.end()) {
+                dependencies.back().push_back(parent->second);
+            }
+
+            MembersMap::const_iterator members = typeInfo.objectToMembers.find(names.back());
+            if (members != typeInfo.objectToMembers.end()) {
+                dependencies.back().insert(dependencies.back().end(), members->second.begin(), members->second.end());
+            }
+        }
+
+        DataStructures sorted;
+        sorted.reserve(found.size());
 
-        InheritanceComparator(const DependencyTypeInfo& typeInfo) : typeInfo(typeInfo) {}
+        for (std::size_t i : drafter::SortByDependencies(names, dependencies)) {
+            sorted.push_back(found[i]);
+        }
 
-        /* This is a comparator for std::sort so it has to compare
-         * objects in strictly weak ordering otherwise it would crash
-         * with sort going out of container bounds, see
-         * http://stackoverflow.com/questions/24048022/what-causes-stdsort-to-access-address-out-of-range
-         * for more details.
-         * The order is following, if F has S as an ancestor or a member
-         * then S < F and conversely, if none of this applies we compare objects by
-         * names to provide some ordering for all objects as we don't
-         * really care.
-         */
-        bool operator()(DataStructures::const_reference first, DataStructures::const_reference second)
+        return sorted;
+    }
+}
+
+namespace
+{
+    struct NameComparator {
+
+        const std::vector<std::string>& names;
+
+        bool operator()(std::size_t first, std::size_t second) const
         {
+            if (names[first] != names[second]) {
+                return names[first] < names[second];
+            }
+
+            return first < second;
+        }
+    };
+}
+
+/* Topological sort (Kahn's algorithm) over the dependency graph, named types
+ * not depending on each other are ordered by name. Cycles through members
+ * are legal (recursive types), named types on such a cycle are collapsed
+ * into one strongly connected component first and ordered by name among
+ * themselves.
+ */
+std::vector<std::size_t> drafter::SortByDependencies(
+    const std::vector<std::string>& names, const std::vector<std::vector<std::string> >& dependencies)
+{
+    assert(names.size() == dependencies.size());
+
+    const std::size_t npos = std::numeric_limits<std::size_t>::max();
+    const std::size_t count = names.size();
+
+    std::map<std::string, std::vector<std::size_t> > nameToIndices;
+    for (std::size_t i = 0; i < count; ++i) {
+        nameToIndices[names[i]].push_back(i);
+    }
+
+    // edges from a dependency to its dependents
+    std::vector<std::vector<std::size_t> > dependents(count);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        for (const auto& dependency : dependencies[i]) {
+            auto indices = nameToIndices.find(dependency);
+            if (indices == nameToIndices.end()) {
+                continue;
+            }
+
+            for (std::size_t j : indices->second) {
+                if (j != i) {
+                    dependents[j].push_back(i);
+                }
+            }
+        }
+    }
+
+    // Tarjan's strongly connected components
+    std::vector<std::size_t> component(count, npos);
+    std::vector<std::size_t> index(count, npos);
+    std::vector<std::size_t> lowlink(count, 0);
+    std::vector<std::size_t> stack;
+    std::size_t visited = 0;
+    std::size_t components = 0;
+
+    // depth-first search with an explicit call stack, so long inheritance
+    // chains do not exhaust the native one; frames hold the vertex and
+    // position of its next edge
+    std::vector<std::pair<std::size_t, std::size_t> > path;
+
+    auto discover = [&](std::size_t v) {
+        index[v] = lowlink[v] = visited++;
+        stack.push_back(v);
+        path.emplace_back(v, 0);
+    };
+
+    for (std::size_t i = 0; i < count; ++i) {
+        if (index[i] != npos) {
+            continue;
+        }
 
-            if (typeInfo.hasAncestor(first.node, second.node) || typeInfo.hasMember(first.node, second.node)) {
-                return false;
+        discover(i);
+
+        while (!path.empty()) {
+            const std::size_t v = path.back().first;
+            const std::size_t edge = path.back().second;
+
+            if (edge < dependents[v].size()) {
+                ++path.back().second;
+
+                const std::size_t w = dependents[v][edge];
+                if (index[w] == npos) {
+                    discover(w);
+                } else if (component[w] == npos) { // w is on stack
+                    lowlink[v] = std::min(lowlink[v], index[w]);
+                }
+                continue;
             }
 
-            if (typeInfo.hasAncestor(second.node, first.node) || typeInfo.hasMember(second.node, first.node)) {
-                return true;
+            if (lowlink[v] == index[v]) {
+                std::size_t w;
+                do {
+                    w = stack.back();
+                    stack.pop_back();
+                    component[w] = components;
+                } while (w != v);
+                ++components;
             }
 
-            return name(first.node) < name(second.node);
+            path.pop_back();
+
+            if (!path.empty()) {
+                const std::size_t u = path.back().first;
+                lowlink[u] = std::min(lowlink[u], lowlink[v]);
+            }
         }
+    }
+
+    const NameComparator byName{ names };
+
+    std::vector<std::vector<std::size_t> > componentMembers(components);
+    for (std::size_t i = 0; i < count; ++i) {
+        componentMembers[component[i]].push_back(i);
+    }
+
+    for (auto& members : componentMembers) {
+        std::sort(members.begin(), members.end(), byName);
+    }
+
+    std::vector<std::size_t> inDegree(components, 0);
+    for (std::size_t i = 0; i < count; ++i) {
+        for (std::size_t dependent : dependents[i]) {
+            if (component[i] != component[dependent]) {
+                ++inDegree[component[dependent]];
+            }
+        }
+    }
+
+    // components are ordered by their lowest named type
+    auto componentByName = [&componentMembers, &byName](std::size_t first, std::size_t second) {
+        return byName(componentMembers[first].front(), componentMembers[second].front());
     };
+    std::set<std::size_t, decltype(componentByName)> ready(componentByName);
+
+    for (std::size_t c = 0; c < components; ++c) {
+        if (inDegree[c] == 0) {
+            ready.insert(c);
+        }
+    }
+
+    std::vector<std::size_t> sorted;
+    sorted.reserve(count);
+
+    while (!ready.empty()) {
+        const std::size_t next = *ready.begin();
+        ready.erase(ready.begin());
+
+        for (std::size_t i : componentMembers[next]) {
+            sorted.push_back(i);
+
+            for (std::size_t dependent : dependents[i]) {
+                const std::size_t c = component[dependent];
+                if (c != next && --inDegree[c] == 0) {
+                    ready.insert(c);
+                }
+            }
+        }
+    }
+
+    assert(sorted.size() == count);
 
+    return sorted;
 }
 
 namespace drafter
@@ -410,7 +518,9 @@ namespace drafter
 
         DependencyTypeInfo typeInfo(found);
 
-        std::sort(found.begin(), found.end(), InheritanceComparator(typeInfo));
+        // circular inheritance is reported by snowcrash, named types are
+        // only registered for blueprints parsed without an error
+        found = SortDataStructures(found, typeInfo);
 
 #ifdef DEBUG_DEPENDENCIES
         std::cout << "==BASE TYPE ORDER==" << std::endl;
@@ -10,6 +10,10 @@
 
 #include "Blueprint.h"
 
+#include <cstddef>
+#include <string>
+#include <vector>
+
 namespace refract
 {
     class Registry;
@@ -24,5 +28,16 @@ namespace drafter
     class ConversionContext;
 
     void RegisterNamedTypes(const NodeInfo<snowcrash::Elements>& elements, ConversionContext& context);
+
+    /* Order named types so every one of them follows its base type and the
+     * named types of its members.
+     *
+     * @param names         name of every named type
+     * @param dependencies  names each named type directly depends on
+     *
+     * @return indices into `names` in registration order
+     */
+    std::vector<std::size_t> SortByDependencies(
+        const std::vector<std::string>& names, const std::vector<std::vector<std::string> >& dependencies);
 }
 #endif // #ifndef DRAFTER_NAMEDTYPESREGISRTY_H
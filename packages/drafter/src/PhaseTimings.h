@@ -0,0 +1,91 @@
+//
+//  PhaseTimings.h
+//  drafter
+//
+//  Copyright (c) 2020 Apiary Inc. All rights reserved.
+//
+
+#ifndef DRAFTER_PHASETIMINGS_H
+#define DRAFTER_PHASETIMINGS_H
+
+#include <chrono>
+
+namespace drafter
+{
+    ///
+    /// Wall time spent in phases of the conversion to API Elements
+    ///
+    /// Collected only when given to ConversionContext::collectTimings,
+    /// see drafter-bench. Phases run on multiple threads add up their
+    /// time on each thread. Phases are exclusive: time spent in a phase
+    /// entered from within another one counts for the inner phase only.
+    ///
+    struct PhaseTimings {
+        using clock = std::chrono::steady_clock;
+        using duration = clock::duration;
+
+        duration expansion = duration::zero();
+        duration valueGeneration = duration::zero();
+        duration schemaGeneration = duration::zero();
+
+        PhaseTimings& operator+=(const PhaseTimings& other) noexcept
+        {
+            expansion += other.expansion;
+            valueGeneration += other.valueGeneration;
+            schemaGeneration += other.schemaGeneration;
+            return *this;
+        }
+    };
+
+    ///
+    /// Add wall time of the enclosing scope to a duration, if given
+    ///
+    /// A ScopedTiming started within another one on the same thread
+    /// pauses the outer one until it ends.
+    ///
+    class ScopedTiming
+    {
+        PhaseTimings::duration* target_;
+        ScopedTiming* outer_ = nullptr;
+        PhaseTimings::clock::time_point start_;
+
+        static ScopedTiming*& innermost() noexcept
+        {
+            static thread_local ScopedTiming* timing = nullptr;
+            return timing;
+        }
+
+    public:
+        explicit ScopedTiming(PhaseTimings::duration* target) noexcept : target_(target)
+        {
+            if (!target_)
+                return;
+
+            start_ = PhaseTimings::clock::now();
+
+            outer_ = innermost();
+            if (outer_)
+                *outer_->target_ += start_ - outer_->start_;
+
+            innermost() = this;
+        }
+
+        ScopedTiming(const ScopedTiming&) = delete;
+        ScopedTiming& operator=(const ScopedTiming&) = delete;
+
+        ~ScopedTiming()
+        {
+            if (!target_)
+                return;
+
+            const auto end = PhaseTimings::clock::now();
+            *target_ += end - start_;
+
+            innermost() = outer_;
+            if (outer_)
+                outer_->start_ = end;
+        }
+    };
+}
+
+#endif
@@ -26,8 +26,12 @@
 #include "backend/MediaTypeS11n.h"
 #include "backend/Backend.h"
 
+#include <atomic>
+#include <exception>
 #include <iterator>
 #include <set>
+#include <system_error>
+#include <thread>
 
 #include "NamedTypesRegistry.h"
 #include "ConversionContext.h"
@@ -99,6 +103,101 @@ namespace
         return element;
     }
 
+    // Convert API description elements on multiple threads, see drafter_set_parallel_conversion
+    //
+    // Each element is converted in its own fork of the context. Results,
+    // warnings and the first failure are then taken over in element order,
+    // so the outcome does not differ from a sequential conversion.
+    void ParallelElementsToRefract(
+        const NodeInfoCollection<snowcrash::Elements>& elements, dsd::Array& content, ConversionContext& context)
+    {
+        struct Task {
+            std::unique_ptr<ConversionContext> context;
+            PhaseTimings timings;
+            std::unique_ptr<IElement> result;
+            std::exception_ptr failure;
+        };
+
+        std::vector<Task> tasks(elements.size());
+
+        std::size_t jobs = std::thread::hardware_concurrency();
+        jobs = std::max<std::size_t>(1, std::min(jobs, tasks.size()));
+
+        std::atomic<std::size_t> next{ 0 };
+        auto worker = [&elements, &tasks, &next, &context]() {
+            for (std::size_t i = next++; i < tasks.size(); i = next++) {
+                auto& task = tasks[i];
+                try {
+                    task.context.reset(new ConversionContext(context, context.timings() ? &task.timings : nullptr));
+                    task.result = ElementToRefract(elements[i], *task.context);
+                } catch (...) {
+                    task.failure = std::current_exception();
+                }
+            }
+        };
+
+        // Started threads are joined however this scope is left
+        struct Pool {
+            std::vector<std::thread> threads;
+
+            ~Pool()
+            {
+                for (auto& thread : threads)
+                    if (thread.joinable())
+                        thread.join();
+            }
+        } pool;
+
+        pool.threads.reserve(jobs - 1);
+        for (std::size_t i = 1; i < jobs; ++i) {
+            try {
+                pool.threads.emplace_back(worker);
+            } catch (const std::system_error& e) {
+                // elements left are taken by the threads running, including this one
+                LOG(warning) << "parallel conversion continues on " << i << " thread(s): " << e.what();
+                break;
+            }
+        }
+
+        worker();
+
+        for (auto& thread : pool.threads)
+            thread.join();
+
+        for (auto& task : tasks) {
+            if (task.context) {
+                context.merge(*task.context);
+            }
+
+            if (context.timings()) {
+                *context.timings() += task.timings;
+            }
+
+            if (task.failure) {
+                std::rethrow_exception(task.failure);
+            }
+
+            content.push_back(std::move(task.result));
+        }
+    }
+
+    void ElementsToRefract(
+        const NodeInfo<snowcrash::Elements>& elements, dsd::Array& content, ConversionContext& context)
+    {
+        // Fan out on the first level with more than one element; forks
+        // convert their elements sequentially
+        if (is_parallel_conversion(context.options()) && !context.isFork()) {
+            NodeInfoCollection<snowcrash::Elements> collection(elements);
+
+            if (collection.size() > 1) {
+                ParallelElementsToRefract(collection, content, context);
+                return;
+            }
+        }
+
+        NodeInfoToElements(elements, ElementToRefract, content, context);
+    }
+
     bool isRequest(const NodeInfo<snowcrash::Action>& action)
     {
         return !action.isNull() && !action.node->method.empty();
@@ -283,29 +382,53 @@ namespace
 
     void generateValueAsset( //
         ArrayElement::ValueType& out,
-        const ConversionContext& context,
+        ConversionContext& context,
         const IElement& expanded,
+        const GeneratedAssets::Key& key,
         const media_type& mediaType)
     {
         using apib::backend::serialize;
         if (apib::isJSON(mediaType)) {
-            std::stringstream ss{};
-            drafter::utils::so::serialize_json(ss, refract::generateJsonValue(expanded));
-            out.push_back(make_asset_element(ss.str(), SerializeKey::MessageBody, serialize(mediaType)));
+            auto& assets = context.generatedAssets();
+            const std::string* body = assets.find(GeneratedAssets::Body, key);
+
+            if (!body) {
+                ScopedTiming timing(context.timings() ? &context.timings()->valueGeneration : nullptr);
+
+                std::stringstream ss{};
+                drafter::utils::so::serialize_json(ss, refract::generateJsonValue(expanded));
+                body = &assets.add(GeneratedAssets::Body, key, ss.str());
+            }
+
+            out.push_back(make_asset_element(*body, SerializeKey::MessageBody, serialize(mediaType)));
         }
     }
 
     void generateSchemaAsset( //
         ArrayElement::ValueType& out,
-        const ConversionContext& context,
+        ConversionContext& context,
         const IElement& expanded,
+        const GeneratedAssets::Key& key,
         const media_type& mediaType)
     {
         using apib::backend::serialize;
         if (apib::isJSON(mediaType)) {
-            std::stringstream ss{};
-            drafter::utils::so::serialize_json(ss, refract::schema::generateJsonSchema(expanded));
-            out.push_back(make_asset_element(ss.str(), SerializeKey::MessageBodySchema, serialize(jsonSchemaType())));
+            auto& assets = context.generatedAssets();
+            const std::string* schema = assets.find(GeneratedAssets::Schema, key);
+
+            if (!schema) {
+                ScopedTiming timing(context.timings() ? &context.timings()->schemaGeneration : nullptr);
+
+                std::stringstream ss{};
+                const auto namedTypes = is_schema_definitions(context.options()) ?
+                    refract::schema::NamedTypes::Definitions :
+                    refract::schema::NamedTypes::Inline;
+
+                drafter::utils::so::serialize_json(ss, refract::schema::generateJsonSchema(expanded, namedTypes));
+                schema = &assets.add(GeneratedAssets::Schema, key, ss.str());
+            }
+
+            out.push_back(make_asset_element(*schema, SerializeKey::MessageBodySchema, serialize(jsonSchemaType())));
         }
     }
 
@@ -392,6 +515,13 @@ std::unique_ptr<IElement> PayloadToRefract( //
         dataStructure = MSONToRefract(MAKE_NODE_INFO(action, attributes), context);
     auto dataStructureExpanded = dataStructure ? ExpandRefract(std::move(dataStructure), context) : nullptr;
 
+    // Key of assets generated from the expanded data structure, computed once for both
+    const bool generateBody = payload.node->body.empty() && !is_skip_gen_bodies(context.options());
+    const bool generateSchema = payload.node->schema.empty() && !is_skip_gen_body_schemas(context.options());
+    const GeneratedAssets::Key assetKey = dataStructureExpanded && apib::isJSON(mediaType) && (generateBody || generateSchema) ?
+        GeneratedAssets::keyOf(*dataStructureExpanded) :
+        GeneratedAssets::Key{ 0, nullptr };
+
     // Push Body Asset
     if (!payload.node->body.empty()) {
         content.push_back(make_asset_element( //
@@ -400,9 +530,9 @@ std::unique_ptr<IElement> PayloadToRefract( //
             serialize(mediaType),
             &payload.sourceMap->body.sourceMap));
 
-    } else if (dataStructureExpanded && !is_skip_gen_bodies(context.options())) {
+    } else if (dataStructureExpanded && generateBody) {
         // otherwise, generate one from attributes
-        generateValueAsset(content, context, *dataStructureExpanded, mediaType);
+        generateValueAsset(content, context, *dataStructureExpanded, assetKey, mediaType);
     }
 
     // Push Schema Asset
@@ -413,9 +543,9 @@ std::unique_ptr<IElement> PayloadToRefract( //
             serialize(apib::isJSON(mediaType) ? jsonSchemaType() : textPlainType()),
             &payload.sourceMap->schema.sourceMap));
 
-    } else if (dataStructureExpanded && !is_skip_gen_body_schemas(context.options())) {
+    } else if (dataStructureExpanded && generateSchema) {
         // otherwise, generate one from attributes
-        generateSchemaAsset(content, context, *dataStructureExpanded, mediaType);
+        generateSchemaAsset(content, context, *dataStructureExpanded, assetKey, mediaType);
     }
 
     return std::move(result);
@@ -575,7 +705,7 @@ std::unique_ptr<ArrayElement> CategoryToRefract(const NodeInfo<snowcrash::Elemen
         const NodeInfo<snowcrash::Elements> elementsNodeInfo
             = MakeNodeInfo(&element.node->content.elements(), GetElementChildrenSourceMap(element));
 
-        NodeInfoToElements(elementsNodeInfo, ElementToRefract, content, context);
+        ElementsToRefract(elementsNodeInfo, content, context);
     }
 
     RemoveEmptyElements(content);
@@ -623,7 +753,7 @@ std::unique_ptr<IElement> drafter::BlueprintToRefract(
             CollectionToRefract<ArrayElement>(MAKE_NODE_INFO(blueprint, metadata), context, MetadataToRefract));
     }
 
-    NodeInfoToElements(MAKE_NODE_INFO(blueprint, content.elements()), ElementToRefract, content, context);
+    ElementsToRefract(MAKE_NODE_INFO(blueprint, content.elements()), content, context);
 
     RemoveEmptyElements(content);
 
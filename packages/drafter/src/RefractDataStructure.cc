@@ -366,7 +366,8 @@ namespace
             case TypeQueryVisitor::Ref:
             case TypeQueryVisitor::Extend:
             case TypeQueryVisitor::Option:
-            case TypeQueryVisitor::Select:;
+            case TypeQueryVisitor::Select:
+            case TypeQueryVisitor::SourceMap:;
         };
         return mson::UndefinedTypeName;
     }
@@ -378,9 +379,7 @@ namespace
             return mson::UndefinedTypeName;
         }
 
-        TypeQueryVisitor query;
-        VisitBy(*e, query);
-        return RefractElementTypeToMsonType(query.get());
+        return RefractElementTypeToMsonType(TypeQueryVisitor::of(*e));
     }
 
     /**
@@ -996,7 +995,7 @@ namespace
             return true;
         }
 
-        if (TypeQueryVisitor::as<StringElement>(FindRootAncestor(
+        if (get<StringElement>(FindRootAncestor(
                 variable.typeDefinition.typeSpecification.name.symbol.literal, context.typeRegistry()))) {
             return true;
         }
@@ -1332,7 +1331,9 @@ std::unique_ptr<IElement> drafter::ExpandRefract(std::unique_ptr<IElement> eleme
         return nullptr;
     }
 
-    ExpandVisitor expander(context.typeRegistry());
+    ScopedTiming timing(context.timings() ? &context.timings()->expansion : nullptr);
+
+    ExpandVisitor expander(context.typeRegistry(), &context.expandedTypes());
     Visit(expander, *element);
 
     if (auto expanded = expander.get()) {
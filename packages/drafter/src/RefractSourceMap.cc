@@ -1,58 +1,58 @@
 #include "RefractSourceMap.h"
 #include "ConversionContext.h"
 
+#include <algorithm>
+#include <limits>
+
 using namespace refract;
 
 namespace
 {
-    std::unique_ptr<IElement> CharacterRangeToRefract(const mdp::CharactersRange& sourceMap)
+    // Source Maps hold 32 bit values, see dsd::SourceMap
+    std::uint32_t Saturated(std::size_t value) noexcept
+    {
+        return static_cast<std::uint32_t>(std::min<std::size_t>(value, std::numeric_limits<std::uint32_t>::max()));
+    }
+
+    dsd::SourceMap::Range PackRange(const mdp::CharactersRange& range) noexcept
+    {
+        return { Saturated(range.location), Saturated(range.length) };
+    }
+
+    dsd::SourceMap::Position PackPosition(const drafter::AnnotationPosition& position) noexcept
     {
-        return make_element<ArrayElement>( //
-            from_primitive(sourceMap.location),
-            from_primitive(sourceMap.length));
+        return { Saturated(position.fromLine),
+            Saturated(position.fromColumn),
+            Saturated(position.toLine),
+            Saturated(position.toColumn) };
     }
 
 } // namespace
 
 std::unique_ptr<IElement> drafter::SourceMapToRefract(const mdp::CharactersRangeSet& sourceMap)
 {
-    auto sourceMapElement = make_element<ArrayElement>();
-    sourceMapElement->element(SerializeKey::SourceMap);
+    std::vector<dsd::SourceMap::Range> ranges;
+    ranges.reserve(sourceMap.size());
 
-    std::transform( //
-        sourceMap.begin(),
-        sourceMap.end(),
-        std::back_inserter(sourceMapElement->get()),
-        CharacterRangeToRefract);
+    std::transform(sourceMap.begin(), sourceMap.end(), std::back_inserter(ranges), PackRange);
 
-    return make_element<ArrayElement>(std::move(sourceMapElement));
+    return make_element<ArrayElement>(make_element<SourceMapElement>(std::move(ranges)));
 }
 
 std::unique_ptr<IElement> drafter::SourceMapToRefractWithColumnLineInfo(
     const mdp::CharactersRangeSet& sourceMap, const ConversionContext& context)
 {
-    auto sourceMapElement = make_element<ArrayElement>();
-    sourceMapElement->element(SerializeKey::SourceMap);
-
-    std::transform( //
-        sourceMap.begin(),
-        sourceMap.end(),
-        std::back_inserter(sourceMapElement->get()),
-        [&context](const mdp::CharactersRange& sourceMap) {
-            auto position = GetLineFromMap(context.newlineIndices(), sourceMap);
-
-            auto location = make_element<NumberElement>(sourceMap.location);
-            location->attributes().set("line", from_primitive(position.fromLine));
-            location->attributes().set("column", from_primitive(position.fromColumn));
-
-            auto length = make_element<NumberElement>(sourceMap.length);
-            length->attributes().set("line", from_primitive(position.toLine));
-            length->attributes().set("column", from_primitive(position.toColumn));
-
-            return make_element<ArrayElement>(std::move(location), std::move(length));
-        });
+    std::vector<dsd::SourceMap::Range> ranges;
+    std::vector<dsd::SourceMap::Position> positions;
+    ranges.reserve(sourceMap.size());
+    positions.reserve(sourceMap.size());
+
+    for (const auto& range : sourceMap) {
+        ranges.push_back(PackRange(range));
+        positions.push_back(PackPosition(GetLineFromMap(context.newlineIndices(), range)));
+    }
 
-    return make_element<ArrayElement>(std::move(sourceMapElement));
+    return make_element<ArrayElement>(make_element<SourceMapElement>(std::move(ranges), std::move(positions)));
 }
 
 std::unique_ptr<StringElement> drafter::LiteralToRefract(
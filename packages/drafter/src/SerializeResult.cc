@@ -60,6 +60,7 @@ std::unique_ptr<IElement> drafter::WrapRefract(
         }
 
         context.typeRegistry().clear();
+        context.expandedTypes().clear();
 
         if (error.code != snowcrash::Error::OK) {
             blueprint.report.error = error;
@@ -1,10 +1,33 @@
 #include "SourceMapUtils.h"
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
 
 #include "utils/Utf8.h"
 
 #include <iostream>
 
+namespace
+{
+    // Whether [first, last) holds ASCII octets only; goes a word at a time
+    // and without early exit, unlike a search for the first non-ASCII octet
+    bool IsAscii(const char* first, const char* last) noexcept
+    {
+        std::uint64_t octets = 0;
+
+        for (; last - first >= 8; first += 8) {
+            std::uint64_t word;
+            std::memcpy(&word, first, sizeof(word));
+            octets |= word;
+        }
+
+        for (; first != last; ++first)
+            octets |= static_cast<unsigned char>(*first);
+
+        return (octets & 0x8080808080808080ull) == 0;
+    }
+} // namespace
+
 namespace drafter
 {
 
@@ -51,18 +74,43 @@ namespace drafter
 
     const NewLinesIndex GetLinesEndIndex(const std::string& source)
     {
+        return GetLinesEndIndex(source.data(), source.size());
+    }
 
+    const NewLinesIndex GetLinesEndIndex(const char* source, std::size_t size)
+    {
         NewLinesIndex out;
 
         out.push_back(0);
 
-        utils::utf8::input_iterator<std::string::const_iterator> it(source);
-        utils::utf8::input_iterator<std::string::const_iterator> e{ source.end(), source.end() };
-
-        int i = 1;
-        for (; it != e; ++it, ++i) {
-            if (*it == '\n')
-                out.push_back(i);
+        const char* it = source;
+        const char* const end = source + size;
+        std::size_t codepoints = 0; // codepoints before `it`
+
+        while (it != end) {
+            const void* nl = std::memchr(it, '\n', end - it);
+            const char* const line_end = nl ? static_cast<const char*>(nl) + 1 : end;
+
+            if (IsAscii(it, line_end)) {
+                // ASCII octets are codepoints of their own
+                codepoints += line_end - it;
+                it = line_end;
+            } else {
+                // decode the line; as with utils::utf8::input_iterator, a
+                // malformed sequence may swallow the newline
+                const char* last = it;
+                while (it < line_end) {
+                    last = it;
+                    it = utils::utf8::decode_one(it, end).second;
+                    ++codepoints;
+                }
+
+                if (last != nl)
+                    continue;
+            }
+
+            if (nl)
+                out.push_back(codepoints);
         }
 
         return out;
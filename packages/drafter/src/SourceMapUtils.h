@@ -38,6 +38,7 @@ namespace drafter
      *  \param out Vector containing indexes of all end line character in source
      */
     const NewLinesIndex GetLinesEndIndex(const std::string& source);
+    const NewLinesIndex GetLinesEndIndex(const char* source, std::size_t size);
 
 } // namespace drafter
 
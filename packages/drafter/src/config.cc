@@ -25,6 +25,8 @@ namespace config
     static const std::string Version = "version";
     static const std::string UseLineNumbers = "use-line-num";
     static const std::string EnableLog = "enable-log";
+    static const std::string Batch = "batch";
+    static const std::string Jobs = "jobs";
 };
 
 void PrepareCommanLineParser(cmdline::parser& parser)
@@ -45,6 +47,13 @@ void PrepareCommanLineParser(cmdline::parser& parser)
     parser.add(
         config::UseLineNumbers, 'u', "use line and row number instead of character index when printing annotation");
     parser.add(config::EnableLog, 'L', "enable logging");
+    parser.add<std::string>(config::Batch,
+        'b',
+        "process API Blueprints listed in manifest file, one path per line ('-' reads stdin); "
+        "outputs are saved next to inputs or into directory given by --output",
+        false);
+    parser.add<unsigned int>(
+        config::Jobs, 'j', "number of documents processed concurrently in batch mode (default: CPU count)", false, 0);
 
     std::stringstream ss;
 
@@ -67,6 +76,11 @@ void ValidateParsedCommandLine(const cmdline::parser& parser, const Config& conf
         exit(EXIT_SUCCESS);
     }
 
+    if (!config.batch.empty() && !parser.rest().empty()) {
+        std::cerr << "input file cannot be combined with --" << config::Batch << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
     if (config.validate) {
         if (parser.exist(config::Output)) {
             std::cerr << "WARN: While validation is enabled, output file will not be created" << std::endl;
@@ -91,6 +105,8 @@ void ParseCommadLineOptions(int argc, const char* argv[], /* out */ Config& conf
     conf.output = parser.get<std::string>(config::Output);
     conf.sourceMap = parser.exist(config::Sourcemap);
     conf.enableLog = parser.exist(config::EnableLog);
+    conf.batch = parser.get<std::string>(config::Batch);
+    conf.jobs = parser.get<unsigned int>(config::Jobs);
 
     ValidateParsedCommandLine(parser, conf);
 }
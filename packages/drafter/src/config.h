@@ -21,6 +21,8 @@ struct Config {
     bool sourceMap;
     std::string output;
     bool enableLog;
+    std::string batch;
+    unsigned int jobs;
 };
 
 /**
@@ -9,14 +9,10 @@
 
 #include "snowcrash.h"
 
-#include "utils/so/JsonIo.h"
-#include "utils/so/YamlIo.h"
-
+#include "refract/Arena.h"
 #include "refract/Element.h"
-#include "refract/FilterVisitor.h"
-#include "refract/Query.h"
-#include "refract/Iterate.h"
-#include "refract/SerializeSo.h"
+#include "refract/ElementUtils.h"
+#include "refract/SerializeStream.h"
 
 #include "SerializeResult.h" // FIXME: remove - actualy required by WrapParseResultRefract()
 #include "ConversionContext.h"
@@ -33,8 +29,13 @@
 #include "reporting.h"
 #include "options.h"
 
+#include <cstdlib>
 #include <cstring>
 #include <cassert>
+#include <atomic>
+#include <mutex>
+#include <streambuf>
+#include <unordered_map>
 
 DRAFTER_API drafter_error drafter_parse_blueprint_to(const char* source,
     char** out,
@@ -64,6 +65,49 @@ DRAFTER_API drafter_error drafter_parse_blueprint_to(const char* source,
 
 namespace sc = snowcrash;
 
+namespace
+{
+    sc::BlueprintParserOptions snowcrashOptions(const drafter_parse_options* parse_opts)
+    {
+        sc::BlueprintParserOptions scOptions = sc::ExportSourcemapOption;
+
+        if (drafter::is_name_required(parse_opts)) {
+            scOptions |= sc::RequireBlueprintNameOption;
+        }
+
+        return scOptions;
+    }
+
+    // Arenas of results parsed with arena_allocated, see drafter_free_result
+    std::mutex resultArenasMutex;
+    std::unordered_map<const drafter_result*, std::unique_ptr<refract::Arena> > resultArenas;
+    std::atomic<std::size_t> resultArenasCount{ 0 }; //< spares heap results the lock
+
+    void adoptArena(const drafter_result* result, std::unique_ptr<refract::Arena> arena)
+    {
+        std::lock_guard<std::mutex> lock(resultArenasMutex);
+        resultArenas[result] = std::move(arena);
+        ++resultArenasCount;
+    }
+
+    std::unique_ptr<refract::Arena> releaseArena(const drafter_result* result)
+    {
+        if (resultArenasCount == 0)
+            return nullptr;
+
+        std::lock_guard<std::mutex> lock(resultArenasMutex);
+
+        auto it = resultArenas.find(result);
+        if (it == resultArenas.end())
+            return nullptr;
+
+        auto arena = std::move(it->second);
+        resultArenas.erase(it);
+        --resultArenasCount;
+        return arena;
+    }
+} // namespace
+
 /* Parse API Bleuprint and return result, which is a opaque handle for
  * later use*/
 DRAFTER_API drafter_error drafter_parse_blueprint(
@@ -73,25 +117,169 @@ DRAFTER_API drafter_error drafter_parse_blueprint(
         return DRAFTER_EINVALID_INPUT;
     }
 
-    sc::BlueprintParserOptions scOptions = sc::ExportSourcemapOption;
-
-    if (drafter::is_name_required(parse_opts)) {
-        scOptions |= sc::RequireBlueprintNameOption;
+    sc::ParseResult<sc::Blueprint> blueprint;
+    sc::parse(source, snowcrashOptions(parse_opts), blueprint);
+
+    // with arena_allocated, Elements of the whole conversion come from the
+    // arena, including intermediates; the scope outlives the context and
+    // everything deleted along the way
+    std::unique_ptr<refract::Arena> arena;
+    if (drafter::is_arena_allocated(parse_opts)) {
+        arena.reset(new refract::Arena);
     }
 
-    sc::ParseResult<sc::Blueprint> blueprint;
-    sc::parse(source, scOptions, blueprint);
+    refract::ArenaScope scope(arena.get());
 
     drafter::ConversionContext context(source, parse_opts);
     auto result = WrapRefract(blueprint, context);
 
     if (out) {
+        if (result && arena) {
+            // result takes over the arena, see drafter_free_result
+            adoptArena(result.get(), std::move(arena));
+        }
+
         *out = result.release();
     }
 
     return (drafter_error)blueprint.report.error.code;
 }
 
+namespace
+{
+    // Stream buffer writing into a malloc'd, NUL terminated block, so the
+    // serialized result can be handed over without another copy
+    class malloc_buf : public std::streambuf
+    {
+        char* data_ = nullptr;
+        std::size_t size_ = 0;
+        std::size_t capacity_ = 0;
+        bool failed_ = false;
+
+        bool reserve(std::size_t n)
+        {
+            if (n <= capacity_)
+                return true;
+
+            std::size_t capacity = capacity_ ? capacity_ : 4096;
+            while (capacity < n)
+                capacity *= 2;
+
+            char* data = static_cast<char*>(std::realloc(data_, capacity));
+            if (!data) {
+                failed_ = true;
+                return false;
+            }
+
+            data_ = data;
+            capacity_ = capacity;
+            return true;
+        }
+
+    protected:
+        int_type overflow(int_type c) override
+        {
+            if (traits_type::eq_int_type(c, traits_type::eof()))
+                return traits_type::not_eof(c);
+
+            const char ch = traits_type::to_char_type(c);
+            return xsputn(&ch, 1) == 1 ? c : traits_type::eof();
+        }
+
+        std::streamsize xsputn(const char* s, std::streamsize n) override
+        {
+            // keep room for the terminating NUL
+            if (!reserve(size_ + n + 1))
+                return 0;
+
+            std::memcpy(data_ + size_, s, n);
+            size_ += n;
+            return n;
+        }
+
+    public:
+        malloc_buf() = default;
+        malloc_buf(const malloc_buf&) = delete;
+        malloc_buf& operator=(const malloc_buf&) = delete;
+
+        ~malloc_buf() override
+        {
+            std::free(data_);
+        }
+
+        // transfer ownership of the NUL terminated result to caller
+        char* release()
+        {
+            if (failed_ || !reserve(size_ + 1))
+                return nullptr;
+
+            data_[size_] = '\0';
+
+            char* result = data_;
+            data_ = nullptr;
+            size_ = capacity_ = 0;
+            return result;
+        }
+    };
+
+    // Stream buffer forwarding chunks of output to a drafter_write_callback
+    class callback_buf : public std::streambuf
+    {
+        static constexpr std::size_t BufferSize = 4096;
+
+        drafter_write_callback callback_;
+        void* context_;
+        char buffer_[BufferSize];
+
+        bool flush()
+        {
+            const std::size_t n = pptr() - pbase();
+            setp(buffer_, buffer_ + BufferSize);
+            return n == 0 || callback_(buffer_, n, context_) == n;
+        }
+
+    protected:
+        int_type overflow(int_type c) override
+        {
+            if (!flush())
+                return traits_type::eof();
+
+            if (!traits_type::eq_int_type(c, traits_type::eof()))
+                sputc(traits_type::to_char_type(c));
+
+            return traits_type::not_eof(c);
+        }
+
+        int sync() override
+        {
+            return flush() ? 0 : -1;
+        }
+
+    public:
+        callback_buf(drafter_write_callback callback, void* context) : callback_(callback), context_(context)
+        {
+            setp(buffer_, buffer_ + BufferSize);
+        }
+    };
+
+    bool serialize(std::ostream& out, const refract::IElement& res, const drafter_serialize_options* serialize_opts)
+    {
+        switch (drafter::get_format(serialize_opts)) {
+            case DRAFTER_SERIALIZE_JSON:
+                refract::serialize::renderJson(out, res, drafter::are_sourcemaps_included(serialize_opts));
+                break;
+            case DRAFTER_SERIALIZE_YAML:
+                refract::serialize::renderYaml(out, res, drafter::are_sourcemaps_included(serialize_opts));
+                break;
+
+            default:
+                return false;
+        }
+
+        return !out.flush().fail();
+    }
+} // namespace
+
 /* Serialize result to given format*/
 DRAFTER_API char* drafter_serialize(drafter_result* res, const drafter_serialize_options* serialize_opts)
 {
@@ -99,25 +287,38 @@ DRAFTER_API char* drafter_serialize(drafter_result* res, const drafter_serialize
         return nullptr;
     }
 
-    std::ostringstream out;
+    malloc_buf buffer;
+    std::ostream out(&buffer);
 
-    switch (drafter::get_format(serialize_opts)) {
-        case DRAFTER_SERIALIZE_JSON: {
-            auto soValue = refract::serialize::renderSo(*res, drafter::are_sourcemaps_included(serialize_opts));
-            drafter::utils::so::serialize_json(out, soValue);
-            break;
-        }
-        case DRAFTER_SERIALIZE_YAML: {
-            auto soValue = refract::serialize::renderSo(*res, drafter::are_sourcemaps_included(serialize_opts));
-            drafter::utils::so::serialize_yaml(out, soValue);
-            break;
-        }
+    if (!serialize(out, *res, serialize_opts)) {
+        return nullptr;
+    }
 
-        default:
-            return nullptr;
+    return buffer.release();
+}
+
+/* Serialize result to given format, streaming output to callback */
+DRAFTER_API drafter_error drafter_serialize_to(drafter_result* res,
+    drafter_write_callback callback,
+    void* context,
+    const drafter_serialize_options* serialize_opts)
+{
+    if (!res) {
+        return DRAFTER_EINVALID_INPUT;
+    }
+
+    if (!callback) {
+        return DRAFTER_EINVALID_OUTPUT;
+    }
+
+    callback_buf buffer(callback, context);
+    std::ostream out(&buffer);
+
+    if (!serialize(out, *res, serialize_opts)) {
+        return DRAFTER_EINVALID_OUTPUT;
     }
 
-    return strdup(out.str().c_str());
+    return DRAFTER_OK;
 }
 
 /* Parse API Blueprint and return only annotations, if NULL than
@@ -129,42 +330,55 @@ DRAFTER_API drafter_error drafter_check_blueprint(
         return DRAFTER_EINVALID_INPUT;
     }
 
-    drafter_result* result = nullptr;
-
-    drafter_error ret = res ? drafter_parse_blueprint(source, &result, parse_opts) :
-                              drafter_parse_blueprint(source, nullptr, parse_opts);
+    // Assets generated from MSON never carry annotations; skip them. The
+    // annotations are moved out of the result, so it must not own an arena.
+    drafter_parse_options options = parse_opts ? *parse_opts : drafter_parse_options{};
+    options.flags.set(drafter_parse_options::SKIP_GEN_BODIES);
+    options.flags.set(drafter_parse_options::SKIP_GEN_BODY_SCHEMAS);
+    options.flags.reset(drafter_parse_options::ARENA_ALLOCATED);
 
-    if (!result) {
-        return ret;
-    }
+    sc::ParseResult<sc::Blueprint> blueprint;
+    sc::parse(source, snowcrashOptions(&options), blueprint);
 
-    drafter_result* out = nullptr;
+    drafter::ConversionContext context(source, &options);
+    auto result = WrapRefract(blueprint, context);
 
-    refract::FilterVisitor filter(refract::query::Element("annotation"));
-    refract::Iterate<refract::Children> iterate(filter);
-    iterate(*result);
+    if (res) {
+        // annotations are direct children of the Parse Result
+        refract::ArrayElement::ValueType annotations;
 
-    if (!filter.empty()) {
-        refract::ArrayElement::ValueType elements;
+        auto parseResult = refract::get<refract::ArrayElement>(result.get());
 
-        std::transform(filter.elements().begin(),
-            filter.elements().end(),
-            std::back_inserter(elements),
-            std::bind(&refract::IElement::clone, std::placeholders::_1, refract::IElement::cAll));
+        if (parseResult && !parseResult->empty()) {
+            for (auto& element : parseResult->get()) {
+                if (element && element->element() == drafter::SerializeKey::Annotation) {
+                    annotations.push_back(std::move(element));
+                }
+            }
+        }
 
-        out = new refract::ArrayElement(elements);
-        out->element(drafter::SerializeKey::ParseResult);
-    }
+        drafter_result* out = nullptr;
 
-    drafter_free_result(result);
+        if (!annotations.empty()) {
+            out = new refract::ArrayElement(std::move(annotations));
+            out->element(drafter::SerializeKey::ParseResult);
+        }
 
-    *res = out;
+        *res = out;
+    }
 
-    return ret;
+    return (drafter_error)blueprint.report.error.code;
 }
 
 DRAFTER_API void drafter_free_result(drafter_result* result)
 {
+    if (!result) {
+        return;
+    }
+
+    auto arena = releaseArena(result);
+
+    refract::ArenaScope scope(arena.get());
     delete result;
 }
 
@@ -196,6 +410,24 @@ DRAFTER_API void drafter_set_skip_gen_body_schemas(drafter_parse_options* opts)
     opts->flags.set(drafter_parse_options::SKIP_GEN_BODY_SCHEMAS);
 }
 
+DRAFTER_API void drafter_set_arena_allocated(drafter_parse_options* opts)
+{
+    assert(opts);
+    opts->flags.set(drafter_parse_options::ARENA_ALLOCATED);
+}
+
+DRAFTER_API void drafter_set_parallel_conversion(drafter_parse_options* opts)
+{
+    assert(opts);
+    opts->flags.set(drafter_parse_options::PARALLEL_CONVERSION);
+}
+
+DRAFTER_API void drafter_set_schema_definitions(drafter_parse_options* opts)
+{
+    assert(opts);
+    opts->flags.set(drafter_parse_options::SCHEMA_DEFINITIONS);
+}
+
 DRAFTER_API drafter_serialize_options* drafter_init_serialize_options()
 {
     return new drafter_serialize_options{};
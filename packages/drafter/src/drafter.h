@@ -31,6 +31,8 @@ extern "C" {
 #endif
 #endif
 
+#include <stddef.h>
+
 #ifndef __cplusplus
 #include <stdbool.h>
 typedef struct drafter_result drafter_result;
@@ -78,6 +80,29 @@ DRAFTER_API void drafter_set_skip_gen_bodies(drafter_parse_options*);
  */
 DRAFTER_API void drafter_set_skip_gen_body_schemas(drafter_parse_options*);
 
+/* Set arena_allocated option
+ *   @remark arena_allocated: all elements created by the conversion are
+ *   allocated from a single arena, which is released at once by
+ *   drafter_free_result; memory of intermediate elements is not reused
+ *   before then, elements converted on other threads by parallel_conversion
+ *   stay heap allocated
+ */
+DRAFTER_API void drafter_set_arena_allocated(drafter_parse_options*);
+
+/* Set parallel_conversion option
+ *   @remark parallel_conversion: resource groups and resources are converted
+ *   to API Elements on multiple threads; the result is the same as without
+ *   the option
+ */
+DRAFTER_API void drafter_set_parallel_conversion(drafter_parse_options*);
+
+/* Set schema_definitions option
+ *   @remark schema_definitions: generated message body schemas render each
+ *   named type once under `definitions` and refer to it by `$ref`, including
+ *   recursive named types
+ */
+DRAFTER_API void drafter_set_schema_definitions(drafter_parse_options*);
+
 /* Serialisation options
  */
 typedef struct drafter_serialize_options drafter_serialize_options;
@@ -135,6 +160,25 @@ DRAFTER_API drafter_error drafter_parse_blueprint(
 /* Serialize result to given format, returns NULL if an error is encountered */
 DRAFTER_API char* drafter_serialize(drafter_result* res, const drafter_serialize_options* serialize_opts);
 
+/* Output callback used by drafter_serialize_to
+ *   @remark called repeatedly with consecutive chunks of serialized output
+ *   @return number of bytes consumed; anything less than size aborts serialisation
+ */
+typedef size_t (*drafter_write_callback)(const char* data, size_t size, void* context);
+
+/* Serialize result to given format, streaming output through callback
+ * without building the whole document in memory.
+ * Returns:
+ * - 0 if everything went smooth.
+ * - DRAFTER_EINVALID_INPUT if result is NULL
+ * - DRAFTER_EINVALID_OUTPUT if callback is NULL, format is unknown or callback
+ *   did not consume all data
+ */
+DRAFTER_API drafter_error drafter_serialize_to(drafter_result* res,
+    drafter_write_callback callback,
+    void* context,
+    const drafter_serialize_options* serialize_opts);
+
 /* Free memory allocated for result handler */
 DRAFTER_API void drafter_free_result(drafter_result* res);
 
@@ -31,3 +31,18 @@ bool drafter::is_skip_gen_body_schemas(const drafter_parse_options* opts) noexce
 {
     return opts && opts->flags.test(drafter_parse_options::SKIP_GEN_BODY_SCHEMAS);
 }
+
+bool drafter::is_arena_allocated(const drafter_parse_options* opts) noexcept
+{
+    return opts && opts->flags.test(drafter_parse_options::ARENA_ALLOCATED);
+}
+
+bool drafter::is_parallel_conversion(const drafter_parse_options* opts) noexcept
+{
+    return opts && opts->flags.test(drafter_parse_options::PARALLEL_CONVERSION);
+}
+
+bool drafter::is_schema_definitions(const drafter_parse_options* opts) noexcept
+{
+    return opts && opts->flags.test(drafter_parse_options::SCHEMA_DEFINITIONS);
+}
@@ -14,11 +14,14 @@
 #include <bitset>
 
 struct drafter_parse_options {
-    using flags_type = std::bitset<3>;
+    using flags_type = std::bitset<6>;
 
     static constexpr std::size_t NAME_REQUIRED = 0;
     static constexpr std::size_t SKIP_GEN_BODIES = 1;
     static constexpr std::size_t SKIP_GEN_BODY_SCHEMAS = 2;
+    static constexpr std::size_t ARENA_ALLOCATED = 3;
+    static constexpr std::size_t PARALLEL_CONVERSION = 4;
+    static constexpr std::size_t SCHEMA_DEFINITIONS = 5;
 
     flags_type flags = 0;
 };
@@ -54,6 +57,21 @@ namespace drafter
      */
     bool is_skip_gen_body_schemas(const drafter_parse_options*) noexcept;
 
+    /* Access arena_allocated option
+     *   @remark arena_allocated: allocate the result from a per-parse arena
+     */
+    bool is_arena_allocated(const drafter_parse_options*) noexcept;
+
+    /* Access parallel_conversion option
+     *   @remark parallel_conversion: convert resource groups on multiple threads
+     */
+    bool is_parallel_conversion(const drafter_parse_options*) noexcept;
+
+    /* Access schema_definitions option
+     *   @remark schema_definitions: render named types once under `definitions` of message body schemas
+     */
+    bool is_schema_definitions(const drafter_parse_options*) noexcept;
+
     /* Access format option
      *   @remark format: API Elements serialisation format (YAML|JSON)
      */
@@ -0,0 +1,209 @@
+//
+//  process.cc
+//  drafter
+//
+//  Copyright (c) 2020 Apiary Inc. All rights reserved.
+//
+
+#include "process.h"
+
+#include "drafter.h"
+#include "reporting.h"
+#include "stream.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    size_t WriteToStream(const char* data, size_t size, void* context)
+    {
+        std::ostream& out = *static_cast<std::ostream*>(context);
+        return out.write(data, size) ? size : 0;
+    }
+
+    struct BatchDocument {
+        std::string input;
+        std::string output;
+
+        int result = 0;
+        bool failed = false; // input or output could not be accessed
+        std::string report;
+    };
+
+    std::vector<std::string> ReadManifest(std::istream& in)
+    {
+        std::vector<std::string> files;
+        std::string line;
+
+        while (std::getline(in, line)) {
+            const auto first = line.find_first_not_of(" \t\r");
+            if (first == std::string::npos || line[first] == '#')
+                continue;
+
+            const auto last = line.find_last_not_of(" \t\r");
+            files.push_back(line.substr(first, last - first + 1));
+        }
+
+        return files;
+    }
+
+    std::string OutputName(const Config& config, const std::string& input)
+    {
+        const auto separator = input.find_last_of("/\\");
+        const auto nameBegin = separator == std::string::npos ? 0 : separator + 1;
+
+        auto extension = input.find_last_of('.');
+        if (extension == std::string::npos || extension <= nameBegin)
+            extension = input.size();
+
+        const std::string suffix = config.format == drafter::JSONFormat ? ".json" : ".yaml";
+
+        if (config.output.empty())
+            return input.substr(0, extension) + suffix;
+
+        return config.output + '/' + input.substr(nameBegin, extension - nameBegin) + suffix;
+    }
+
+    void ProcessBatchDocument(const Config& config, BatchDocument& document)
+    {
+        std::ostringstream report;
+
+        std::ifstream in(document.input, std::ios_base::in | std::ios_base::binary);
+        if (!in.is_open()) {
+            report << "\nfatal: unable to open file '" << document.input << "'\n";
+            document.failed = true;
+            document.report = report.str();
+            return;
+        }
+
+        std::stringstream source;
+        source << in.rdbuf();
+
+        if (config.validate) {
+            document.result = ProcessDocument(config, source.str(), nullptr, report);
+        } else {
+            std::ofstream out(document.output, std::ios_base::out | std::ios_base::binary);
+            if (!out.is_open()) {
+                report << "\nfatal: unable to open file '" << document.output << "'\n";
+                document.failed = true;
+                document.report = report.str();
+                return;
+            }
+
+            document.result = ProcessDocument(config, source.str(), &out, report);
+        }
+
+        document.report = report.str();
+    }
+} // namespace
+
+int ProcessDocument(const Config& config, const std::string& source, std::ostream* out, std::ostream& report)
+{
+    drafter_serialize_options* options = drafter_init_serialize_options();
+    if (config.sourceMap)
+        drafter_set_sourcemaps_included(options);
+    if (config.format == drafter::JSONFormat)
+        drafter_set_format(options, DRAFTER_SERIALIZE_JSON);
+
+    refract::IElement* result = nullptr;
+
+    // TODO: Read parse options from CLI
+    drafter_parse_options* parseOptions = drafter_init_parse_options();
+    // without output only annotations are reported, no need for a complete Parse Result
+    int ret = out ? drafter_parse_blueprint(source.c_str(), &result, parseOptions) :
+                    drafter_check_blueprint(source.c_str(), &result, parseOptions);
+    drafter_free_parse_options(parseOptions);
+
+    // drafter_check_blueprint yields no result for documents without annotations
+    if (!result && (out || ret != 0)) {
+        drafter_free_serialize_options(options);
+        return -1;
+    }
+
+    if (out) {
+        if (drafter_serialize_to(result, WriteToStream, out, options) == DRAFTER_OK) {
+            *out << "\n" << std::flush;
+        }
+    }
+
+    drafter_free_serialize_options(options);
+
+    PrintReport(report, result, source, config.lineNumbers, ret);
+
+    drafter_free_result(result);
+
+    return ret;
+}
+
+int ProcessBatch(const Config& config)
+{
+    std::vector<std::string> files;
+    {
+        std::unique_ptr<std::istream> manifest(
+            CreateStreamFromName<std::istream>(config.batch == "-" ? std::string() : config.batch));
+        files = ReadManifest(*manifest);
+    }
+
+    std::vector<BatchDocument> documents(files.size());
+    std::set<std::string> outputs;
+
+    for (std::size_t i = 0; i < files.size(); ++i) {
+        documents[i].input = files[i];
+
+        if (!config.validate) {
+            documents[i].output = OutputName(config, files[i]);
+
+            if (!outputs.insert(documents[i].output).second) {
+                std::cerr << "fatal: '" << files[i] << "' would overwrite output file '" << documents[i].output
+                          << "'\n";
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    std::size_t jobs = config.jobs > 0 ? config.jobs : std::thread::hardware_concurrency();
+    jobs = std::max<std::size_t>(1, std::min(jobs, documents.size()));
+
+    std::atomic<std::size_t> next{ 0 };
+    auto worker = [&config, &documents, &next]() {
+        for (std::size_t i = next++; i < documents.size(); i = next++)
+            ProcessBatchDocument(config, documents[i]);
+    };
+
+    std::vector<std::thread> pool;
+    for (std::size_t i = 1; i < jobs; ++i)
+        pool.emplace_back(worker);
+
+    worker();
+
+    for (auto& thread : pool)
+        thread.join();
+
+    int ret = 0;
+    std::size_t withErrors = 0;
+
+    for (const auto& document : documents) {
+        std::cerr << document.input << ":" << document.report;
+
+        if (document.failed || document.result != 0) {
+            ++withErrors;
+
+            if (ret == 0)
+                ret = document.failed ? EXIT_FAILURE : document.result;
+        }
+    }
+
+    std::cerr << "\n"
+              << documents.size() << " documents processed, " << withErrors << " failed" << std::endl;
+
+    return ret;
+}
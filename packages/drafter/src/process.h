@@ -0,0 +1,40 @@
+//
+//  process.h
+//  drafter
+//
+//  Copyright (c) 2020 Apiary Inc. All rights reserved.
+//
+
+#ifndef DRAFTER_PROCESS_H
+#define DRAFTER_PROCESS_H
+
+#include <iosfwd>
+#include <string>
+
+#include "config.h"
+
+/**
+ *  \brief Parse API Blueprint, serialize the Parse Result and report annotations
+ *
+ *  Safe to call concurrently; each call uses its own parse state.
+ *
+ *  \param config drafter-cli configuration
+ *  \param source API Blueprint source
+ *  \param out stream the Parse Result is serialized to, nullptr to skip serialization
+ *  \param report stream annotations are reported to
+ *
+ *  \return parse result code as returned by drafter_parse_blueprint()
+ */
+int ProcessDocument(const Config& config, const std::string& source, std::ostream* out, std::ostream& report);
+
+/**
+ *  \brief Process all API Blueprints listed in config.batch on a pool of config.jobs threads
+ *
+ *  Outputs are written next to the inputs, or into config.output directory if set.
+ *  Reports are printed to stderr in manifest order, followed by a summary.
+ *
+ *  \return first non-zero result in manifest order, 0 if all documents are OK
+ */
+int ProcessBatch(const Config& config);
+
+#endif // #ifndef DRAFTER_PROCESS_H
@@ -0,0 +1,117 @@
+//
+//  refract/Arena.cc
+//  librefract
+//
+//  Copyright (c) 2020 Apiary Inc. All rights reserved.
+//
+
+#include "Arena.h"
+
+#include "ElementIfc.h"
+
+#include <algorithm>
+#include <new>
+
+using namespace refract;
+
+namespace
+{
+    constexpr std::size_t MaxBlockSize = 1024 * 1024;
+
+    thread_local Arena* currentArena = nullptr;
+
+    std::size_t aligned(std::size_t size)
+    {
+        return (size + Arena::alignment - 1) & ~(Arena::alignment - 1);
+    }
+} // namespace
+
+constexpr std::size_t Arena::alignment;
+
+Arena::Arena(std::size_t initialBlockSize) : nextBlockSize_(aligned(std::max<std::size_t>(initialBlockSize, 1))) {}
+
+void* Arena::allocate(std::size_t size)
+{
+    size = aligned(size);
+
+    if (size > left_) {
+        // oversized requests get a block of their own, current block stays in use
+        if (size > nextBlockSize_ / 2) {
+            blocks_.emplace_back(new char[size]);
+            char* block = blocks_.back().get();
+            extents_.emplace(block, block + size);
+            reserved_ += size;
+            ++allocations_;
+            return block;
+        }
+
+        blocks_.emplace_back(new char[nextBlockSize_]);
+        block_ = current_ = blocks_.back().get();
+        left_ = nextBlockSize_;
+        extents_.emplace(current_, current_ + nextBlockSize_);
+        reserved_ += nextBlockSize_;
+
+        nextBlockSize_ = std::min(nextBlockSize_ * 2, MaxBlockSize);
+    }
+
+    void* result = current_;
+    current_ += size;
+    left_ -= size;
+    ++allocations_;
+
+    return result;
+}
+
+bool Arena::owns(const void* p) const noexcept
+{
+    const char* c = static_cast<const char*>(p);
+
+    // Elements are mostly deleted soon after being allocated
+    if (c >= block_ && c < current_)
+        return true;
+
+    auto it = extents_.upper_bound(c);
+    if (it == extents_.begin())
+        return false;
+
+    --it;
+    return c < it->second;
+}
+
+bool Arena::owns(const IElement& e) const noexcept
+{
+    return owns(dynamic_cast<const void*>(&e));
+}
+
+ArenaScope::ArenaScope(Arena* arena) noexcept : previous_(currentArena)
+{
+    currentArena = arena;
+}
+
+ArenaScope::~ArenaScope()
+{
+    currentArena = previous_;
+}
+
+Arena* ArenaScope::current() noexcept
+{
+    return currentArena;
+}
+
+void* IElement::operator new(std::size_t size)
+{
+    if (Arena* arena = currentArena)
+        return arena->allocate(size);
+
+    return ::operator new(size);
+}
+
+void IElement::operator delete(void* p) noexcept
+{
+    // arena memory is released together with the arena
+    if (Arena* arena = currentArena)
+        if (arena->owns(p))
+            return;
+
+    ::operator delete(p);
+}
@@ -0,0 +1,112 @@
+//
+//  refract/Arena.h
+//  librefract
+//
+//  Copyright (c) 2020 Apiary Inc. All rights reserved.
+//
+
+#ifndef REFRACT_ARENA_H
+#define REFRACT_ARENA_H
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace refract
+{
+    struct IElement;
+
+    ///
+    /// Monotonic memory arena for Elements
+    ///
+    /// While an ArenaScope is active on a thread, all Elements allocated
+    /// on that thread are placed into the scope's Arena. Deleting such an
+    /// Element runs its destructor but does not release its memory; the
+    /// whole Arena is released at once when it is destroyed.
+    ///
+    /// Elements carry no record of where they were allocated; the active
+    /// scope decides how they are deallocated.
+    ///
+    /// @note   the Arena must outlive all Elements allocated from it
+    /// @note   Elements allocated from an Arena must be deleted within an
+    ///         ArenaScope of the same Arena
+    ///
+    class Arena
+    {
+        std::vector<std::unique_ptr<char[]> > blocks_;
+        std::map<const char*, const char*> extents_; //< [begin, end) of blocks_ by begin
+        char* block_ = nullptr; //< begin of the block current_ points into
+        char* current_ = nullptr;
+        std::size_t left_ = 0;
+        std::size_t nextBlockSize_;
+
+        std::size_t allocations_ = 0;
+        std::size_t reserved_ = 0;
+
+    public:
+        static constexpr std::size_t alignment = alignof(std::max_align_t);
+
+        explicit Arena(std::size_t initialBlockSize = 16 * 1024);
+
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        ///
+        /// Allocate memory, aligned to Arena::alignment
+        ///
+        void* allocate(std::size_t size);
+
+        ///
+        /// Query the number of allocations served by this Arena
+        ///
+        std::size_t allocations() const noexcept
+        {
+            return allocations_;
+        }
+
+        ///
+        /// Query the number of bytes reserved from the heap
+        ///
+        std::size_t reserved() const noexcept
+        {
+            return reserved_;
+        }
+
+        ///
+        /// Query whether memory was allocated from this Arena
+        ///
+        bool owns(const void* p) const noexcept;
+
+        ///
+        /// Query whether an Element was allocated from this Arena
+        ///
+        bool owns(const IElement& e) const noexcept;
+    };
+
+    ///
+    /// Route Element allocations of current thread into an Arena
+    ///
+    /// Scopes nest; the previously active Arena is restored on destruction.
+    ///
+    class ArenaScope
+    {
+        Arena* previous_;
+
+    public:
+        explicit ArenaScope(Arena* arena) noexcept;
+        ~ArenaScope();
+
+        ArenaScope(const ArenaScope&) = delete;
+        ArenaScope& operator=(const ArenaScope&) = delete;
+
+        ///
+        /// Query the Arena Elements are currently allocated from
+        ///
+        /// @return active Arena; nullptr if Elements are heap allocated
+        ///
+        static Arena* current() noexcept;
+    };
+}
+
+#endif
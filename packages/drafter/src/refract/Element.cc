@@ -13,6 +13,8 @@
 #include <string>
 #include <cstring>
 #include <array>
+#include <vector>
+#include <algorithm>
 
 #include "ComparableVisitor.h"
 #include "TypeQueryVisitor.h"
@@ -50,3 +52,16 @@ bool refract::isReserved(const std::string& w) noexcept
 {
     return isReserved(w.c_str());
 }
+
+bool refract::isReserved(const Symbol& w)
+{
+    static const std::vector<Symbol> reserved = [] {
+        std::vector<Symbol> result;
+        result.reserve(reserved_.size());
+        for (const char* word : reserved_)
+            result.emplace_back(word);
+        return result;
+    }();
+
+    return std::find(reserved.begin(), reserved.end(), w) != reserved.end();
+}
@@ -40,7 +40,13 @@ namespace refract
         bool hasValue_ = false; //< Whether DSD is set
         DataType data_ = {};    //< DSD
 
-        std::string name_ = { DataType::name }; //< Name of the Element
+        Symbol name_ = defaultName(); //< Name of the Element
+
+        static Symbol defaultName()
+        {
+            static const Symbol name{ DataType::name };
+            return name;
+        }
 
     public:
         using ValueType = DataType; //< DSD type definition
@@ -56,12 +62,13 @@ namespace refract
         /// Initialize a Refract Element from a DSD
         /// @remark sets name of the element to DataType::name
         ///
-        explicit Element(DataType data) : hasValue_(true), data_(std::move(data)), name_(DataType::name) {}
+        explicit Element(DataType data) : hasValue_(true), data_(std::move(data)) {}
 
         ///
         /// Initialize a Refract Element from given name and DSD
         ///
         Element(const std::string& name, DataType data) : hasValue_(true), data_(data), name_(name) {}
+        Element(Symbol name, DataType data) : hasValue_(true), data_(data), name_(std::move(name)) {}
 
         Element(Element&&) = default;
         Element(const Element&) = default;
@@ -109,14 +116,24 @@ namespace refract
             return attributes_;
         }
 
-        std::string element() const override
+        const Symbol& element() const noexcept override
         {
             return name_;
         }
 
         void element(const std::string& name) override
         {
-            name_ = name;
+            name_ = Symbol(name);
+        }
+
+        void element(Symbol name) noexcept override
+        {
+            name_ = std::move(name);
+        }
+
+        ElementType type() const noexcept override
+        {
+            return element_type_of<Element>::value;
         }
 
         void content(Visitor& v) const override
@@ -134,13 +151,15 @@ namespace refract
             auto el = refract::make_unique<Element>();
 
             if (flags & IElement::cElement)
-                el->element(name_);
+                el->name_ = name_;
             if (flags & IElement::cAttributes)
                 el->attributes_ = attributes_;
             if (flags & IElement::cMeta) {
-                el->meta_ = meta_; // FIXME use copy_if rather than full copy with remove
-                if (flags & IElement::cNoMetaId)
-                    el->meta_.erase("id");
+                if (flags & IElement::cNoMetaId) {
+                    static const Symbol id{ "id" };
+                    el->meta_.clone(meta_, id);
+                } else
+                    el->meta_ = meta_;
             }
             if (flags & IElement::cValue) {
                 el->hasValue_ = hasValue_;
@@ -199,6 +218,7 @@ namespace refract
 
     bool isReserved(const char* w) noexcept;
     bool isReserved(const std::string& w) noexcept;
+    bool isReserved(const Symbol& w);
 }
 
 #endif
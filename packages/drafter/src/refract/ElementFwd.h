@@ -9,6 +9,8 @@
 #ifndef REFRACT_ELEMENTFWD_H
 #define REFRACT_ELEMENTFWD_H
 
+#include <type_traits>
+
 namespace refract
 {
     namespace dsd
@@ -26,6 +28,7 @@ namespace refract
         class Extend;
         class Option;
         class Select;
+        class SourceMap;
     }
 
     template <typename>
@@ -48,6 +51,67 @@ namespace refract
 
     using OptionElement = Element<dsd::Option>;
     using SelectElement = Element<dsd::Select>;
+
+    using SourceMapElement = Element<dsd::SourceMap>;
+
+    ///
+    /// Intrinsic type of an Element, given by its data structure definition (DSD)
+    /// @remark order matches TypeQueryVisitor::ElementType
+    ///
+    enum class ElementType
+    {
+        Null,
+        Holder,
+
+        String,
+        Number,
+        Boolean,
+
+        Array,
+        Member,
+        Object,
+        Enum,
+
+        Ref,
+        Extend,
+
+        Option,
+        Select,
+
+        SourceMap,
+    };
+
+    ///
+    /// Query the intrinsic type of an Element type at compile time
+    ///
+    template <typename ElementT>
+    struct element_type_of;
+
+    template <typename ElementT>
+    struct element_type_of<const ElementT> : element_type_of<ElementT> {
+    };
+
+#define REFRACT_ELEMENT_TYPE_OF(ELEMENT)                                                                               \
+    template <>                                                                                                        \
+    struct element_type_of<ELEMENT##Element> : std::integral_constant<ElementType, ElementType::ELEMENT> {             \
+    };
+
+    REFRACT_ELEMENT_TYPE_OF(Null)
+    REFRACT_ELEMENT_TYPE_OF(Holder)
+    REFRACT_ELEMENT_TYPE_OF(String)
+    REFRACT_ELEMENT_TYPE_OF(Number)
+    REFRACT_ELEMENT_TYPE_OF(Boolean)
+    REFRACT_ELEMENT_TYPE_OF(Array)
+    REFRACT_ELEMENT_TYPE_OF(Member)
+    REFRACT_ELEMENT_TYPE_OF(Object)
+    REFRACT_ELEMENT_TYPE_OF(Enum)
+    REFRACT_ELEMENT_TYPE_OF(Ref)
+    REFRACT_ELEMENT_TYPE_OF(Extend)
+    REFRACT_ELEMENT_TYPE_OF(Option)
+    REFRACT_ELEMENT_TYPE_OF(Select)
+    REFRACT_ELEMENT_TYPE_OF(SourceMap)
+
+#undef REFRACT_ELEMENT_TYPE_OF
 }
 
 #endif
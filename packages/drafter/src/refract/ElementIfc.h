@@ -9,9 +9,13 @@
 #ifndef REFRACT_ELEMENTIFC_H
 #define REFRACT_ELEMENTIFC_H
 
+#include <cstddef>
 #include <string>
 #include <memory>
 
+#include "ElementFwd.h"
+#include "Symbol.h"
+
 namespace refract
 {
     class InfoElements;
@@ -69,7 +73,7 @@ namespace refract
         ///
         /// @return Element name
         ///
-        virtual std::string element() const = 0;
+        virtual const Symbol& element() const noexcept = 0;
 
         ///
         /// Set name of this Element
@@ -77,6 +81,14 @@ namespace refract
         /// @param new name
         ///
         virtual void element(const std::string&) = 0;
+        virtual void element(Symbol) noexcept = 0;
+
+        ///
+        /// Query the intrinsic type of this Element
+        ///
+        /// @return type given by the DSD of this Element
+        ///
+        virtual ElementType type() const noexcept = 0;
 
         ///
         /// Visit the data structure representation (DSD) of this Element
@@ -110,6 +122,17 @@ namespace refract
         virtual bool empty() const = 0;
 
         virtual ~IElement() = default;
+
+        ///
+        /// Allocate an Element, from the active Arena if there is one
+        /// @see ArenaScope
+        ///
+        static void* operator new(std::size_t size);
+
+        ///
+        /// Deallocate an Element; no-op for Elements allocated from the active Arena
+        ///
+        static void operator delete(void* p) noexcept;
     };
 
     ///
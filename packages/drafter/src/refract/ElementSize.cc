@@ -179,6 +179,12 @@ cardinal refract::sizeOf(const SelectElement& e, bool inheritsFixed)
     return sizeOfSum(e.get().begin(), e.get().end(), inheritsFixed);
 }
 
+cardinal refract::sizeOf(const SourceMapElement& e, bool inheritsFixed)
+{
+    LOG(warning) << "ignoring source map calculating type cardinality";
+    return cardinal::empty();
+}
+
 cardinal refract::sizeOf(const OptionElement& e, bool inheritsFixed)
 {
     if (e.empty())
@@ -23,9 +23,9 @@ namespace refract
     ///             otherwise given Element cast to given type
     ///
     template <typename Element>
-    Element* get(IElement* e)
+    Element* get(IElement* e) noexcept
     {
-        return dynamic_cast<Element*>(e);
+        return (e && e->type() == element_type_of<Element>::value) ? static_cast<Element*>(e) : nullptr;
     }
 
     ///
@@ -36,9 +36,9 @@ namespace refract
     ///             otherwise given Element cast to given type
     ///
     template <typename Element>
-    const Element* get(const IElement* e)
+    const Element* get(const IElement* e) noexcept
     {
-        return dynamic_cast<const Element*>(e);
+        return (e && e->type() == element_type_of<Element>::value) ? static_cast<const Element*>(e) : nullptr;
     }
 } // namespace refract
 
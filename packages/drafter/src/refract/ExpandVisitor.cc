@@ -24,6 +24,7 @@
 #define VISIT_IMPL(ELEMENT)                                                                                            \
     void ExpandVisitor::operator()(const ELEMENT##Element& e)                                                          \
     {                                                                                                                  \
+        Context::Visit visit(*context);                                                                                \
         result = Expand(e, context);                                                                                   \
     }
 
@@ -33,13 +34,6 @@ namespace refract
     namespace
     {
 
-        bool Expandable(const IElement& e)
-        {
-            IsExpandableVisitor v;
-            VisitBy(e, v);
-            return v.get();
-        }
-
         void CopyMetaId(IElement& dst, const IElement& src)
         {
             auto name = src.meta().find("id");
@@ -108,12 +102,12 @@ namespace refract
             return std::reverse_iterator<It>(std::forward<It>(it));
         }
 
-        std::unique_ptr<ExtendElement> GetInheritanceTree(const std::string& name, const Registry& registry)
+        std::unique_ptr<ExtendElement> GetInheritanceTree(const Symbol& name, const Registry& registry)
         {
-            using inheritance_map = std::vector<std::pair<std::string, std::unique_ptr<IElement> > >;
+            using inheritance_map = std::vector<std::pair<Symbol, std::unique_ptr<IElement> > >;
 
             inheritance_map inheritance;
-            std::string en = name;
+            Symbol en = name;
 
             // walk recursive in registry and expand inheritance tree
             for (const IElement* parent = registry.find(en); parent && !isReserved(en);
@@ -129,7 +123,7 @@ namespace refract
 
                 inheritance.emplace_back(
                     en, clone(*parent, ((IElement::cAll ^ IElement::cElement) | IElement::cNoMetaId)));
-                inheritance.back().second->meta().set("ref", from_primitive(en));
+                inheritance.back().second->meta().set("ref", from_primitive(en.str()));
             }
 
             if (inheritance.empty())
@@ -154,13 +148,146 @@ namespace refract
         }
     } // anonymous namespace
 
+    const ExpandedTypes::Entry* ExpandedTypes::find(const Symbol& name) const
+    {
+        auto i = entries_.find(name);
+
+        if (i == entries_.end()) {
+            return nullptr;
+        }
+
+        return &i->second;
+    }
+
+    void ExpandedTypes::add(Symbol name, Entry entry)
+    {
+        entries_[name] = std::move(entry);
+    }
+
+    void ExpandedTypes::clear()
+    {
+        entries_.clear();
+    }
+
+    std::size_t ExpandedTypes::size() const noexcept
+    {
+        return entries_.size();
+    }
+
     struct ExpandVisitor::Context {
 
+        // Named type expansion in progress, candidate for ExpandedTypes
+        struct Recording {
+            std::size_t depth;                  //< position of the expanded type in `members`
+            std::unordered_set<Symbol> dependencies; //< named types visited so far
+            bool cacheable;                     //< no circular reference cut off outside of this expansion
+        };
+
         const Registry& registry;
         ExpandVisitor* expand;
-        std::deque<std::string> members;
+        ExpandedTypes* cache;
+        std::deque<Symbol> members;
+        std::vector<Recording> recordings;
+        ExpandableMemo expandable; //< expandability of visited elements
+        std::size_t visits = 0;    //< nesting of ExpandVisitor calls
+
+        Context(const Registry& registry, ExpandVisitor* expand, ExpandedTypes* cache)
+            : registry(registry), expand(expand), cache(cache)
+        {
+        }
+
+        // Memo is keyed by address, keep it for a single top level visit
+        struct Visit {
+            Context& context;
+
+            explicit Visit(Context& context) : context(context)
+            {
+                ++context.visits;
+            }
+
+            ~Visit()
+            {
+                if (--context.visits == 0) {
+                    context.expandable.clear();
+                }
+            }
+        };
+
+        // Memoized, so nested containers are walked just once per expansion
+        bool Expandable(const IElement& e)
+        {
+            IsExpandableVisitor v(&expandable);
+            VisitBy(e, v);
+            return v.get();
+        }
+
+        // Expand a temporary inheritance tree; memo entries die along with it
+        std::unique_ptr<ExtendElement> ExpandTemporary(std::unique_ptr<ExtendElement> tree)
+        {
+            auto extend = ExpandMembers(*tree);
+            tree.reset();
+            expandable.clear();
+            return extend;
+        }
+
+        // Find named type in stack of expanded members
+        std::deque<Symbol>::const_iterator FindMember(const Symbol& name)
+        {
+            for (auto& recording : recordings) {
+                recording.dependencies.insert(name);
+            }
 
-        Context(const Registry& registry, ExpandVisitor* expand) : registry(registry), expand(expand) {}
+            auto found = std::find(members.cbegin(), members.cend(), name);
+
+            if (found != members.cend()) {
+                // expansions started above the found member depend on context
+                const std::size_t depth = found - members.cbegin();
+                for (auto& recording : recordings) {
+                    if (depth < recording.depth) {
+                        recording.cacheable = false;
+                    }
+                }
+            }
+
+            return found;
+        }
+
+        // Cached expansion is reusable if none of its named types is being expanded
+        bool IsReusable(const ExpandedTypes::Entry& entry) const
+        {
+            return members.cend() == std::find_if(members.cbegin(), members.cend(), [&entry](const Symbol& name) {
+                return entry.dependencies.find(name) != entry.dependencies.end();
+            });
+        }
+
+        std::unique_ptr<ExtendElement> ExpandInheritanceTree(const Symbol& name)
+        {
+            if (!cache) {
+                return ExpandTemporary(GetInheritanceTree(name, registry));
+            }
+
+            if (const ExpandedTypes::Entry* entry = cache->find(name)) {
+                if (IsReusable(*entry)) {
+                    for (auto& recording : recordings) {
+                        recording.dependencies.insert(entry->dependencies.begin(), entry->dependencies.end());
+                    }
+                    return clone(static_cast<const ExtendElement&>(*entry->expanded));
+                }
+            }
+
+            recordings.push_back(Recording{ members.size() - 1, { name }, true });
+
+            auto extend = ExpandTemporary(GetInheritanceTree(name, registry));
+
+            Recording recording = std::move(recordings.back());
+            recordings.pop_back();
+
+            if (recording.cacheable) {
+                cache->add(name, ExpandedTypes::Entry{ clone(*extend), std::move(recording.dependencies) });
+            }
+
+            return extend;
+        }
 
         std::unique_ptr<IElement> ExpandOrClone(const IElement* e) const
         {
@@ -204,7 +331,7 @@ namespace refract
         {
 
             // Look for Circular Reference thro members
-            if (std::find(members.begin(), members.end(), e.element()) != members.end()) {
+            if (FindMember(e.element()) != members.end()) {
                 // To avoid unfinised recursion just clone
                 const IElement* root = FindRootAncestor(e.element(), registry);
 
@@ -213,14 +340,14 @@ namespace refract
 
                 auto result = clone(*root, IElement::cMeta | IElement::cAttributes | IElement::cNoMetaId);
 
-                result->meta().set("ref", from_primitive(e.element()));
+                result->meta().set("ref", from_primitive(e.element().str()));
 
                 return result;
             }
 
             members.push_back(e.element());
 
-            auto extend = ExpandMembers(*GetInheritanceTree(e.element(), registry));
+            auto extend = ExpandInheritanceTree(e.element());
 
             CopyMetaId(*extend, e);
 
@@ -239,13 +366,13 @@ namespace refract
         std::unique_ptr<RefElement> ExpandReference(const RefElement& e)
         {
             auto ref = clone(e);
-            const auto& symbol = ref->get().symbol();
-
-            if (symbol.empty()) {
+            if (ref->get().symbol().empty()) {
                 return ref;
             }
 
-            if (std::find(members.begin(), members.end(), symbol) != members.end()) {
+            const Symbol symbol(ref->get().symbol());
+
+            if (FindMember(symbol) != members.end()) {
 
                 std::stringstream msg;
                 msg << "named type '";
@@ -273,7 +400,7 @@ namespace refract
     struct ExpandElement {
         std::unique_ptr<IElement> operator()(const T& e, ExpandVisitor::Context* context)
         {
-            if (!isReserved(e.element().c_str())) { // expand named type
+            if (!isReserved(e.element())) { // expand named type
                 return context->ExpandNamedType(e);
             }
             return nullptr;
@@ -292,7 +419,7 @@ namespace refract
     struct ExpandElement<EnumElement, EnumElement::ValueType, false> {
         std::unique_ptr<IElement> operator()(const EnumElement& e, ExpandVisitor::Context* context)
         {
-            if (!isReserved(e.element().c_str()))
+            if (!isReserved(e.element()))
                 return context->ExpandNamedType(e);
 
             auto o = e.empty() ? //
@@ -303,7 +430,7 @@ namespace refract
 
             for (const auto& attribute : e.attributes()) {
                 if (attribute.first == "enumerations") {
-                    const auto* enums = TypeQueryVisitor::as<const ArrayElement>(attribute.second.get());
+                    const auto* enums = get<const ArrayElement>(attribute.second.get());
                     assert(enums);
                     assert(!enums->empty());
 
@@ -326,7 +453,7 @@ namespace refract
     struct ExpandElement<T, dsd::Select, true> {
         std::unique_ptr<IElement> operator()(const T& e, ExpandVisitor::Context* context)
         {
-            if (!Expandable(e)) { // do we have some expandable members?
+            if (!context->Expandable(e)) { // do we have some expandable members?
                 return nullptr;
             }
 
@@ -348,13 +475,11 @@ namespace refract
     struct ExpandElement<T, V, true> {
         std::unique_ptr<IElement> operator()(const T& e, ExpandVisitor::Context* context)
         {
-            if (!Expandable(e)) { // do we have some expandable members?
+            if (!context->Expandable(e)) { // do we have some expandable members?
                 return nullptr;
             }
 
-            std::string en = e.element();
-
-            if (!isReserved(en.c_str())) { // expand named type
+            if (!isReserved(e.element())) { // expand named type
                 return context->ExpandNamedType(e);
             } else { // walk throught members and expand them
                 return context->ExpandMembers(e);
@@ -369,7 +494,7 @@ namespace refract
     struct ExpandElement<T, dsd::Member, false> {
         std::unique_ptr<IElement> operator()(const T& e, ExpandVisitor::Context* context)
         {
-            if (!Expandable(e)) {
+            if (!context->Expandable(e)) {
                 return nullptr;
             }
 
@@ -388,7 +513,8 @@ namespace refract
         return ExpandElement<T>()(e, context);
     }
 
-    ExpandVisitor::ExpandVisitor(const Registry& registry) : result(nullptr), context(new Context(registry, this)){};
+    ExpandVisitor::ExpandVisitor(const Registry& registry, ExpandedTypes* cache)
+        : result(nullptr), context(new Context(registry, this, cache)){};
 
     ExpandVisitor::~ExpandVisitor()
     {
@@ -406,6 +532,9 @@ namespace refract
     // do nothing, NullElements are not expandable
     void ExpandVisitor::operator()(const NullElement& e) {}
 
+    // do nothing, SourceMapElements are not expandable
+    void ExpandVisitor::operator()(const SourceMapElement& e) {}
+
     VISIT_IMPL(String)
     VISIT_IMPL(Number)
     VISIT_IMPL(Boolean)
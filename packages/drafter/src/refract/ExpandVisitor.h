@@ -11,20 +11,54 @@
 
 #include "ElementFwd.h"
 #include "ElementIfc.h"
+#include "Symbol.h"
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace refract
 {
 
     class Registry;
 
+    ///
+    /// Memoized expansions of named types
+    ///
+    /// Holds the expanded inheritance tree of named types, so a type is
+    /// expanded just once per registry and later references clone the result.
+    /// An entry is only valid for the registry it was expanded against, clear
+    /// the cache whenever that registry changes.
+    ///
+    class ExpandedTypes
+    {
+    public:
+        struct Entry {
+            std::unique_ptr<IElement> expanded;  //< ExtendElement
+            std::unordered_set<Symbol> dependencies; //< named types visited while expanding
+        };
+
+        using entry_map = std::unordered_map<Symbol, Entry>;
+
+    private:
+        entry_map entries_;
+
+    public:
+        const Entry* find(const Symbol& name) const;
+
+        void add(Symbol name, Entry entry);
+        void clear();
+
+        std::size_t size() const noexcept;
+    };
+
     class ExpandVisitor
     {
 
     public:
         struct Context;
 
-        ExpandVisitor(const Registry& registry);
+        ExpandVisitor(const Registry& registry, ExpandedTypes* cache = nullptr);
         ~ExpandVisitor();
 
         void operator()(const IElement& e);
@@ -48,6 +82,8 @@ namespace refract
         void operator()(const OptionElement& e);
         void operator()(const SelectElement& e);
 
+        void operator()(const SourceMapElement& e);
+
         // return expanded elemnt or NULL if expansion is not needed
         // caller responsibility is to delete returned Element
         std::unique_ptr<IElement> get();
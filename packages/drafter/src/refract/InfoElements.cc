@@ -10,99 +10,194 @@
 
 #include <cassert>
 #include <algorithm>
+#include <new>
 #include "Element.h"
 #include "dsd/ElementData.h"
 #include "TypeQueryVisitor.h"
 
 namespace refract
 {
-    InfoElements::InfoElements() : elements() {}
+    constexpr InfoElements::size_type InfoElements::inline_capacity;
 
-    InfoElements::InfoElements(InfoElements&& other) : InfoElements()
+    InfoElements::InfoElements() noexcept {}
+
+    InfoElements::~InfoElements()
+    {
+        clear();
+        if (capacity_ > inline_capacity)
+            ::operator delete(heap_);
+    }
+
+    InfoElements::InfoElements(const InfoElements& other) : InfoElements()
+    {
+        clone(other);
+    }
+
+    InfoElements::InfoElements(InfoElements&& other) noexcept : InfoElements()
+    {
+        adopt(other);
+    }
+
+    InfoElements& InfoElements::operator=(const InfoElements& rhs)
     {
-        swap(*this, other);
+        if (this != &rhs) {
+            InfoElements copy(rhs);
+            *this = std::move(copy);
+        }
+        return *this;
     }
 
-    InfoElements& InfoElements::operator=(InfoElements rhs)
+    InfoElements& InfoElements::operator=(InfoElements&& rhs) noexcept
     {
-        swap(*this, rhs);
+        if (this != &rhs) {
+            clear();
+            if (capacity_ > inline_capacity) {
+                ::operator delete(heap_);
+                capacity_ = inline_capacity;
+            }
+            adopt(rhs);
+        }
         return *this;
     }
 
+    // expects `this` empty with inline storage; leaves `other` empty
+    void InfoElements::adopt(InfoElements& other) noexcept
+    {
+        assert(size_ == 0 && capacity_ == inline_capacity);
+
+        if (other.capacity_ > inline_capacity) {
+            heap_ = other.heap_;
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+
+            other.size_ = 0;
+            other.capacity_ = inline_capacity;
+            return;
+        }
+
+        value_type* to = data();
+        for (auto& entry : other)
+            new (to++) value_type(std::move(entry));
+        size_ = other.size_;
+        other.clear();
+    }
+
+    void InfoElements::reserve(size_type capacity)
+    {
+        if (capacity <= capacity_)
+            return;
+
+        auto* storage = static_cast<value_type*>(::operator new(capacity * sizeof(value_type)));
+
+        value_type* to = storage;
+        for (auto& entry : *this) {
+            new (to++) value_type(std::move(entry));
+            entry.~value_type();
+        }
+
+        if (capacity_ > inline_capacity)
+            ::operator delete(heap_);
+
+        heap_ = storage;
+        capacity_ = static_cast<std::uint32_t>(capacity);
+    }
+
+    InfoElements::value_type& InfoElements::emplace_back(Symbol key, std::unique_ptr<IElement> value)
+    {
+        if (size_ == capacity_)
+            reserve(2 * capacity_);
+
+        auto* entry = new (data() + size_) value_type(std::move(key), std::move(value));
+        ++size_;
+        return *entry;
+    }
+
+    // destroy elements from `first` to end
+    void InfoElements::truncate(iterator first) noexcept
+    {
+        for (iterator it = first; it != end(); ++it)
+            it->~value_type();
+        size_ = static_cast<std::uint32_t>(first - begin());
+    }
+
     InfoElements::const_iterator InfoElements::begin() const noexcept
     {
-        return elements.begin();
+        return data();
     }
 
     InfoElements::iterator InfoElements::begin() noexcept
     {
-        return elements.begin();
+        return data();
     }
 
     InfoElements::const_iterator InfoElements::end() const noexcept
     {
-        return elements.end();
+        return data() + size_;
     }
 
     InfoElements::iterator InfoElements::end() noexcept
     {
-        return elements.end();
+        return data() + size_;
     }
 
     void InfoElements::erase(iterator it)
     {
-        elements.erase(it);
+        assert(it >= begin() && it < end());
+        truncate(std::move(it + 1, end(), it));
     }
 
-    void InfoElements::clear()
+    void InfoElements::clear() noexcept
     {
-        elements.clear();
+        truncate(begin());
     }
 
     bool InfoElements::empty() const noexcept
     {
-        return elements.empty();
+        return size_ == 0;
     }
 
-    InfoElements::Container::size_type InfoElements::size() const noexcept
+    InfoElements::size_type InfoElements::size() const noexcept
     {
-        return elements.size();
+        return size_;
     }
 
-    InfoElements::InfoElements(const InfoElements& other) : elements()
+    void InfoElements::clone(const InfoElements& other)
     {
-        elements.reserve(other.size());
-        std::transform(
-            other.begin(), other.end(), std::back_inserter(elements), [](const InfoElements::value_type& el) {
-                assert(el.second);
-                return std::make_pair(el.first, refract::clone(*el.second));
-            });
+        reserve(size() + other.size());
+        for (const auto& el : other) {
+            assert(el.second);
+            emplace_back(el.first, refract::clone(*el.second));
+        }
     }
 
-    void InfoElements::clone(const InfoElements& other)
+    void InfoElements::clone(const InfoElements& other, const Symbol& skipped)
     {
-        std::transform(
-            other.begin(), other.end(), std::back_inserter(elements), [](const InfoElements::value_type& el) {
-                assert(el.second);
-                return std::make_pair(el.first, refract::clone(*el.second));
-            });
+        reserve(size() + other.size());
+        for (const auto& el : other) {
+            assert(el.second);
+            if (el.first != skipped)
+                emplace_back(el.first, refract::clone(*el.second));
+        }
     }
 
     void InfoElements::erase(const std::string& key)
     {
-        elements.erase(std::remove_if(elements.begin(),
-                           elements.end(),
-                           [&key](const InfoElements::value_type& keyValue) { return keyValue.first == key; }),
-            elements.end());
+        truncate(std::remove_if(
+            begin(), end(), [&key](const InfoElements::value_type& keyValue) { return keyValue.first == key; }));
     }
 
     IElement& InfoElements::set(const std::string& key, std::unique_ptr<IElement> value)
+    {
+        return set(Symbol(key), std::move(value));
+    }
+
+    IElement& InfoElements::set(Symbol key, std::unique_ptr<IElement> value)
     {
         auto& valueRef = *value;
 
         auto it = find(key);
         if (it == end())
-            elements.emplace_back(key, std::move(value));
+            emplace_back(std::move(key), std::move(value));
         else
             it->second = std::move(value);
 
@@ -117,7 +212,7 @@ namespace refract
     std::unique_ptr<IElement> InfoElements::claim(const std::string& key)
     {
         auto member = find(key);
-        if (member != elements.end()) {
+        if (member != end()) {
             return claim(member);
         }
         return nullptr;
@@ -126,22 +221,34 @@ namespace refract
     std::unique_ptr<IElement> InfoElements::claim(iterator it)
     {
         std::unique_ptr<IElement> result(it->second.release());
-        elements.erase(it);
+        erase(it);
 
         return result;
     }
 
     InfoElements::const_iterator InfoElements::find(const std::string& name) const
     {
-        return std::find_if(elements.begin(), elements.end(), [&name](const InfoElements::value_type& keyValue) {
+        return std::find_if(begin(), end(), [&name](const InfoElements::value_type& keyValue) {
             return keyValue.first == name;
         });
     }
 
     InfoElements::iterator InfoElements::find(const std::string& name)
     {
-        return std::find_if(elements.begin(), elements.end(), [&name](const InfoElements::value_type& keyValue) {
+        return std::find_if(begin(), end(), [&name](const InfoElements::value_type& keyValue) {
             return keyValue.first == name;
         });
     }
+
+    InfoElements::const_iterator InfoElements::find(const Symbol& name) const noexcept
+    {
+        return std::find_if(
+            begin(), end(), [name](const InfoElements::value_type& keyValue) { return keyValue.first == name; });
+    }
+
+    InfoElements::iterator InfoElements::find(const Symbol& name) noexcept
+    {
+        return std::find_if(
+            begin(), end(), [name](const InfoElements::value_type& keyValue) { return keyValue.first == name; });
+    }
 }
@@ -9,38 +9,76 @@
 #ifndef REFRACT_INFO_ELEMENTS_H
 #define REFRACT_INFO_ELEMENTS_H
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
-#include <vector>
+#include <type_traits>
+#include <utility>
 
 #include "ElementIfc.h"
+#include "Symbol.h"
 
 namespace refract
 {
+    ///
+    /// Ordered key-value collection of Element meta and attributes
+    ///
+    /// Up to `inline_capacity` entries are held inline; only larger
+    /// collections allocate, which most Elements never need.
+    ///
     class InfoElements final
     {
-        using Container = std::vector<std::pair<std::string, std::unique_ptr<IElement> > >;
-        Container elements;
-
     public:
-        using iterator = typename Container::iterator;
-        using const_iterator = typename Container::const_iterator;
-        using value_type = typename Container::value_type;
+        using value_type = std::pair<Symbol, std::unique_ptr<IElement> >;
+        using iterator = value_type*;
+        using const_iterator = const value_type*;
+        using size_type = std::size_t;
+
+        static constexpr size_type inline_capacity = 2;
+
+    private:
+        using Slot = typename std::aligned_storage<sizeof(value_type), alignof(value_type)>::type;
+
+        std::uint32_t size_ = 0;
+        std::uint32_t capacity_ = inline_capacity;
+
+        union {
+            Slot inline_[inline_capacity];
+            value_type* heap_;
+        };
+
+        value_type* data() noexcept
+        {
+            return capacity_ > inline_capacity ? heap_ : reinterpret_cast<value_type*>(inline_);
+        }
+
+        const value_type* data() const noexcept
+        {
+            return capacity_ > inline_capacity ? heap_ : reinterpret_cast<const value_type*>(inline_);
+        }
+
+        void reserve(size_type capacity);
+        value_type& emplace_back(Symbol key, std::unique_ptr<IElement> value);
+        void truncate(iterator first) noexcept;
+        void adopt(InfoElements& other) noexcept;
 
     public:
-        InfoElements();
-        ~InfoElements() = default;
+        InfoElements() noexcept;
+        ~InfoElements();
 
         InfoElements(const InfoElements&);
-        InfoElements(InfoElements&&);
+        InfoElements(InfoElements&&) noexcept;
 
-        InfoElements& operator=(InfoElements);
+        InfoElements& operator=(const InfoElements&);
+        InfoElements& operator=(InfoElements&&) noexcept;
 
     public:
-        friend void swap(InfoElements& lhs, InfoElements& rhs)
+        friend void swap(InfoElements& lhs, InfoElements& rhs) noexcept
         {
-            using std::swap;
-            swap(lhs.elements, rhs.elements);
+            InfoElements tmp(std::move(lhs));
+            lhs = std::move(rhs);
+            rhs = std::move(tmp);
         }
 
     public:
@@ -55,23 +93,30 @@ namespace refract
         const_iterator find(const std::string& name) const;
         iterator find(const std::string& name);
 
+        const_iterator find(const Symbol& name) const noexcept;
+        iterator find(const Symbol& name) noexcept;
+
         IElement& set(const std::string& key, std::unique_ptr<IElement> value);
         IElement& set(const std::string& key, const IElement& value);
+        IElement& set(Symbol key, std::unique_ptr<IElement> value);
 
         /// clone elements from `other` to `this`
         void clone(const InfoElements& other);
 
+        /// clone elements from `other` to `this`, except the one keyed `skipped`
+        void clone(const InfoElements& other, const Symbol& skipped);
+
         void erase(const std::string& key);
         void erase(iterator it);
 
         std::unique_ptr<IElement> claim(const std::string& key);
         std::unique_ptr<IElement> claim(iterator it);
 
-        void clear();
+        void clear() noexcept;
 
         bool empty() const noexcept;
 
-        Container::size_type size() const noexcept;
+        size_type size() const noexcept;
     };
 }
 
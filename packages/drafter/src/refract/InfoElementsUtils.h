@@ -10,8 +10,8 @@
 #define REFRACT_INFO_ELEMENTS_UTILS_H
 
 #include "InfoElements.h"
-#include "TypeQueryVisitor.h"
 #include "Element.h"
+#include "ElementUtils.h"
 
 namespace refract
 {
@@ -51,7 +51,7 @@ namespace refract
         if (ta == ie.end()) {
             ie.set(key, make_element<ValueElementType>(from_primitive("fixed")));
         } else {
-            auto arr = TypeQueryVisitor::as<ValueElementType>(ta->second.get());
+            auto arr = get<ValueElementType>(ta->second.get());
 
             // not appropriate type of value
             assert(arr);
@@ -63,7 +63,7 @@ namespace refract
 
             const auto e = arr->get().end();
             if (e == std::find_if(arr->get().begin(), e, [&value](const std::unique_ptr<IElement>& attr) {
-                    if (const auto& str = TypeQueryVisitor::as<Element<DSDType> >(attr.get())) {
+                    if (const auto& str = get<Element<DSDType> >(attr.get())) {
                         if (str->get() == value.get())
                             return true;
                     }
@@ -15,18 +15,29 @@ namespace refract
     {
         bool checkElement(const IElement* e)
         {
-            std::string type;
+            return !e || !isReserved(e->element());
+        }
 
-            if (e) {
-                type = e->element();
+        bool isExpandable(const IElement& e, ExpandableMemo* memo)
+        {
+            if (memo) {
+                auto it = memo->find(&e);
+                if (it != memo->end())
+                    return it->second;
             }
 
-            return !isReserved(type.c_str());
+            IsExpandableVisitor v(memo);
+            VisitBy(e, v);
+
+            if (memo)
+                memo->emplace(&e, v.get());
+
+            return v.get();
         }
 
         template <typename T, typename V = typename T::ValueType, bool IsIterable = dsd::is_iterable<V>::value>
         struct IsExpandable {
-            bool operator()(const T* e) const
+            bool operator()(const T* e, ExpandableMemo* memo) const
             {
 
                 if (checkElement(e)) {
@@ -39,7 +50,7 @@ namespace refract
 
         template <typename T>
         struct IsExpandable<T, RefElement::ValueType, false> {
-            bool operator()(const T* e) const
+            bool operator()(const T* e, ExpandableMemo* memo) const
             {
 
                 return true;
@@ -48,7 +59,7 @@ namespace refract
 
         template <typename T>
         struct IsExpandable<T, SelectElement::ValueType, true> {
-            bool operator()(const T* e) const
+            bool operator()(const T* e, ExpandableMemo* memo) const
             {
 
                 if (checkElement(e)) {
@@ -57,10 +68,7 @@ namespace refract
 
                 if (!e->empty())
                     for (const auto& option : e->get()) {
-                        IsExpandableVisitor v;
-                        VisitBy(*option, v);
-
-                        if (v.get()) {
+                        if (isExpandable(*option, memo)) {
                             return true;
                         }
                     }
@@ -71,7 +79,7 @@ namespace refract
 
         template <typename T>
         struct IsExpandable<T, MemberElement::ValueType, false> {
-            bool operator()(const T* e) const
+            bool operator()(const T* e, ExpandableMemo* memo) const
             {
 
                 if (checkElement(e)) {
@@ -84,17 +92,13 @@ namespace refract
                 const auto& content = e->get();
 
                 if (const IElement* key = content.key()) {
-                    IsExpandableVisitor v;
-                    VisitBy(*key, v);
-                    if (v.get()) {
+                    if (isExpandable(*key, memo)) {
                         return true;
                     }
                 }
 
                 if (const IElement* value = content.value()) {
-                    IsExpandableVisitor v;
-                    VisitBy(*value, v);
-                    if (v.get()) {
+                    if (isExpandable(*value, memo)) {
                         return true;
                     }
                 }
@@ -105,7 +109,7 @@ namespace refract
 
         template <typename T, typename V>
         struct IsExpandable<T, V, true> {
-            bool operator()(const T* e) const
+            bool operator()(const T* e, ExpandableMemo* memo) const
             {
 
                 if (checkElement(e)) {
@@ -114,10 +118,7 @@ namespace refract
 
                 if (!e->empty())
                     for (const auto& entry : e->get()) {
-                        IsExpandableVisitor v;
-                        VisitBy(*entry, v);
-
-                        if (v.get()) {
+                        if (isExpandable(*entry, memo)) {
                             return true;
                         }
                     }
@@ -128,23 +129,19 @@ namespace refract
 
         template <>
         struct IsExpandable<EnumElement, EnumElement::ValueType, false> {
-            bool operator()(const EnumElement* e) const
+            bool operator()(const EnumElement* e, ExpandableMemo* memo) const
             {
                 if (checkElement(e))
                     return true;
 
                 if (!e->empty()) {
-                    IsExpandableVisitor v;
-                    VisitBy(*e->get().value(), v);
-                    if (v.get())
+                    if (isExpandable(*e->get().value(), memo))
                         return true;
                 }
 
                 const auto it = e->attributes().find("enumerations");
                 if (it != e->attributes().end()) {
-                    IsExpandableVisitor v;
-                    VisitBy(*it->second, v);
-                    if (v.get())
+                    if (isExpandable(*it->second, memo))
                         return true;
                 }
 
@@ -153,12 +150,14 @@ namespace refract
         };
     } // anonymous namespace
 
-    IsExpandableVisitor::IsExpandableVisitor() : result(false) {}
+    IsExpandableVisitor::IsExpandableVisitor() : result(false), memo(nullptr) {}
+
+    IsExpandableVisitor::IsExpandableVisitor(ExpandableMemo* memo) : result(false), memo(memo) {}
 
     template <typename T>
     void IsExpandableVisitor::operator()(const T& e)
     {
-        result = IsExpandable<T>()(&e);
+        result = IsExpandable<T>()(&e, memo);
     }
 
     template <>
@@ -181,6 +180,7 @@ namespace refract
     template void IsExpandableVisitor::operator()<ExtendElement>(const ExtendElement&);
     template void IsExpandableVisitor::operator()<OptionElement>(const OptionElement&);
     template void IsExpandableVisitor::operator()<SelectElement>(const SelectElement&);
+    template void IsExpandableVisitor::operator()<SourceMapElement>(const SourceMapElement&);
 
     bool IsExpandableVisitor::get() const
     {
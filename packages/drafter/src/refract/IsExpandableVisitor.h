@@ -9,16 +9,29 @@
 #ifndef REFRACT_ISEXPANDABLEVISITOR_H
 #define REFRACT_ISEXPANDABLEVISITOR_H
 
+#include "ElementFwd.h"
+#include <unordered_map>
+
 namespace refract
 {
 
+    ///
+    /// Expandability of already visited elements
+    ///
+    /// Entries are keyed by address, so they are only valid as long as
+    /// the visited elements are alive and unchanged.
+    ///
+    using ExpandableMemo = std::unordered_map<const IElement*, bool>;
+
     class IsExpandableVisitor
     {
 
         bool result;
+        ExpandableMemo* memo;
 
     public:
         IsExpandableVisitor();
+        explicit IsExpandableVisitor(ExpandableMemo* memo);
 
         template <typename T>
         void operator()(const T& e);
@@ -22,12 +22,12 @@ namespace refract
 
             template <typename U, bool IsIterable = dsd::is_iterable<U>::value, bool IsPair = dsd::is_pair<U>::value>
             struct Impl {
-                void operator()(IApply* apply, Visitor&, const U&) {}
+                void operator()(Visitor& apply, Visitor&, const U&) {}
             };
 
             template <typename U, bool IsPair>
             struct Impl<U, true, IsPair> {
-                void operator()(IApply* apply, Visitor& v, const U& e)
+                void operator()(Visitor& apply, Visitor& v, const U& e)
                 {
                     for (const auto& child : e) {
                         if (!child)
@@ -39,7 +39,7 @@ namespace refract
 
             template <typename U, bool IsIterable>
             struct Impl<U, IsIterable, true> {
-                void operator()(IApply* apply, Visitor& v, const U& e)
+                void operator()(Visitor& apply, Visitor& v, const U& e)
                 {
                     if (auto key = e.key()) {
                         key->content(v);
@@ -51,9 +51,9 @@ namespace refract
                 }
             };
 
-            void operator()(IApply* apply, Visitor& iterable, const T& e)
+            void operator()(Visitor& apply, Visitor& iterable, const T& e)
             {
-                apply->visit(e);
+                apply.visit(e);
 
                 if (!e.empty())
                     Impl<V>()(apply, iterable, e.get());
@@ -61,7 +61,7 @@ namespace refract
         };
 
         template <typename T>
-        void operator()(IApply* apply, Visitor& iterable, const T& e)
+        void operator()(Visitor& apply, Visitor& iterable, const T& e)
         {
             Iterate<T>()(apply, iterable, e);
         }
@@ -74,12 +74,12 @@ namespace refract
 
             template <typename U, bool IsIterable = dsd::is_iterable<U>::value>
             struct Impl {
-                void operator()(Children* strategy, IApply* apply, Visitor&, const U&) {}
+                void operator()(Children* strategy, Visitor& apply, Visitor&, const U&) {}
             };
 
             template <typename U>
             struct Impl<U, true> {
-                void operator()(Children* strategy, IApply* apply, Visitor& v, const U& e)
+                void operator()(Children* strategy, Visitor& apply, Visitor& v, const U& e)
                 {
                     if (strategy->level) { // we need no go deeply
                         return;
@@ -95,7 +95,7 @@ namespace refract
                 }
             };
 
-            void operator()(Children* strategy, IApply* apply, Visitor& iterable, const T& e)
+            void operator()(Children* strategy, Visitor& apply, Visitor& iterable, const T& e)
             {
                 Impl<V>()(strategy, apply, iterable, e.get());
             }
@@ -105,10 +105,10 @@ namespace refract
         Children() : level(0) {}
 
         template <typename T>
-        void operator()(IApply* apply, Visitor& iterable, const T& e)
+        void operator()(Visitor& apply, Visitor& iterable, const T& e)
         {
             if (level == 1) {
-                apply->visit(e);
+                apply.visit(e);
             }
             Iterate<T>()(this, apply, iterable, e);
         }
@@ -122,7 +122,7 @@ namespace refract
 
             Strategy* strategy;
             Visitor* iterator;
-            IApply* apply;
+            Visitor* apply;
 
             void operator()(const IElement& e)
             {
@@ -135,32 +135,28 @@ namespace refract
             {
                 if (!apply) {
                     return;
-                    // apply->visit(e);
+                    // apply.visit(e);
                 }
-                (*strategy)(apply, *iterator, e);
+                (*strategy)(*apply, *iterator, e);
             }
         };
 
         Impl impl;
         Visitor iterator;
         Strategy strategy;
-        IApply* apply;
+        Visitor apply;
 
     public:
         template <typename Functor>
-        explicit Iterate(Functor& functor) : impl(), iterator(impl), strategy(), apply(new ApplyImpl<Functor>(functor))
+        explicit Iterate(Functor& functor) : impl(), iterator(impl), strategy(), apply(functor)
         {
             impl.strategy = &strategy;
             impl.iterator = &iterator;
-            impl.apply = apply;
+            impl.apply = &apply;
         }
 
-        ~Iterate()
-        {
-            if (apply) {
-                delete apply;
-            }
-        }
+        Iterate(const Iterate&) = delete;
+        Iterate& operator=(const Iterate&) = delete;
 
         void operator()(const IElement& e)
         {
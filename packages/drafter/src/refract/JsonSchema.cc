@@ -21,6 +21,9 @@
 #include <algorithm>
 #include <bitset>
 #include <cassert>
+#include <iterator>
+#include <unordered_map>
+#include <vector>
 
 using namespace refract;
 using namespace schema;
@@ -190,6 +193,38 @@ namespace
         return schema;
     }
 
+    ///
+    /// Renders a reference to a named type in `definitions`; the name is
+    ///   escaped as JSON Pointer token and percent-encoded as URI fragment
+    ///
+    std::string definitionRef(const std::string& name)
+    {
+        constexpr const char* hex = "0123456789ABCDEF";
+
+        std::string result = "#/definitions/";
+        for (unsigned char c : name) {
+            if (c == '~')
+                result += "~0";
+            else if (c == '/')
+                result += "~1";
+            else if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '-' || c == '.'
+                || c == '_')
+                result += c;
+            else {
+                result += '%';
+                result += hex[c >> 4];
+                result += hex[c & 0xF];
+            }
+        }
+        return result;
+    }
+
+    so::Object& addRef(so::Object& schema, const std::string& name)
+    {
+        schema.data.emplace_back("$ref", so::String{ definitionRef(name) });
+        return schema;
+    }
+
     so::Object nullSchema()
     {
         return so::Object{ so::from_list{}, std::make_pair("type", so::String{ "null" }) };
@@ -327,45 +362,190 @@ namespace
     void reduce(so::Object& schema);
 } // namespace
 
+namespace
+{ // named types rendered once, see NamedTypes::Definitions
+    ///
+    /// Named type schemas collected while rendering; passed along like
+    ///   TypeAttributes, nullptr renders every named type inline
+    ///
+    struct Definitions {
+        static constexpr std::size_t Schema = std::size_t(-1); //< `rendering` the schema itself
+
+        const IElement* root;                                //< rendered in full even if it is a named type
+        so::Object entries;                                  //< named type schemas in order of first use
+        std::unordered_map<std::string, std::size_t> index; //< position of named types in `entries`
+
+        std::size_t rendering;                       //< position of the entry being rendered, or Schema
+        std::vector<std::size_t> schemaRefs;         //< entries the schema itself refers to
+        std::vector<std::vector<std::size_t> > refs; //< entries each entry refers to
+
+        explicit Definitions(const IElement* root)
+            : root(root), entries(), index(), rendering(Schema), schemaRefs(), refs()
+        {
+        }
+
+        void refer(std::size_t position)
+        {
+            (rendering == Schema ? schemaRefs : refs.at(rendering)).push_back(position);
+        }
+
+        ///
+        /// Take the entries some `$ref` of the schema leads to, in order of
+        ///   first use; entries only ever rendered inline are dropped
+        ///
+        so::Object takeReferred()
+        {
+            std::vector<bool> referred(entries.data.size(), false);
+            std::vector<std::size_t> pending = schemaRefs;
+
+            while (!pending.empty()) {
+                const std::size_t position = pending.back();
+                pending.pop_back();
+
+                if (referred[position])
+                    continue;
+
+                referred[position] = true;
+                pending.insert(pending.end(), refs[position].begin(), refs[position].end());
+            }
+
+            so::Object result{};
+            for (std::size_t i = 0; i < entries.data.size(); ++i)
+                if (referred[i])
+                    result.data.emplace_back(std::move(entries.data[i]));
+
+            return result;
+        }
+    };
+
+    constexpr std::size_t Definitions::Schema;
+
+    ///
+    /// Name of the named type an expanded element was cloned from
+    ///
+    /// @return name in meta `ref`; nullptr if there is none
+    ///
+    const std::string* namedTypeOf(const IElement& e)
+    {
+        auto it = e.meta().find("ref");
+        if (it == e.meta().end())
+            return nullptr;
+
+        const auto* ref = get<const StringElement>(it->second.get());
+        if (!ref || ref->empty() || ref->get().get().empty())
+            return nullptr;
+
+        return &ref->get().get();
+    }
+
+    template <typename V>
+    bool holdsNothing(const V& value, std::true_type)
+    {
+        return value.empty();
+    }
+
+    template <typename V>
+    bool holdsNothing(const V&, std::false_type)
+    {
+        return false;
+    }
+
+    struct HoldsValueVisitor {
+        template <typename ElementT>
+        bool operator()(const ElementT& el)
+        {
+            using ValueType = typename ElementT::ValueType;
+            return !el.empty() && !holdsNothing(el.get(), dsd::is_iterable<ValueType>{});
+        }
+    };
+
+    ///
+    /// Whether the element a named type is used by adds anything to it;
+    ///   only attributes not affecting JSON Schema are ignored
+    ///
+    bool refinesNamedType(const IElement& origin)
+    {
+        for (const auto& attribute : origin.attributes())
+            if (attribute.first != "sourceMap" && attribute.first != "samples" && attribute.first != "default")
+                return true;
+
+        return refract::visit(origin, HoldsValueVisitor{});
+    }
+} // namespace
+
 namespace
 {
-    void renderPropertySpecific(ObjectSchema& schema, const ArrayElement& element, TypeAttributes options);
-    void renderPropertySpecific(ObjectSchema& schema, const BooleanElement& element, TypeAttributes options);
-    void renderPropertySpecific(ObjectSchema& schema, const EnumElement& element, TypeAttributes options);
-    void renderPropertySpecific(ObjectSchema& schema, const ExtendElement& element, TypeAttributes options);
-    void renderPropertySpecific(ObjectSchema& schema, const HolderElement& element, TypeAttributes options);
-    void renderPropertySpecific(ObjectSchema& schema, const MemberElement& element, TypeAttributes options);
-    void renderPropertySpecific(ObjectSchema& schema, const NullElement& element, TypeAttributes options);
-    void renderPropertySpecific(ObjectSchema& schema, const NumberElement& element, TypeAttributes options);
-    void renderPropertySpecific(ObjectSchema& schema, const ObjectElement& element, TypeAttributes options);
-    void renderPropertySpecific(ObjectSchema& schema, const OptionElement& element, TypeAttributes options);
-    void renderPropertySpecific(ObjectSchema& schema, const RefElement& element, TypeAttributes options);
-    void renderPropertySpecific(ObjectSchema& schema, const SelectElement& element, TypeAttributes options);
-    void renderPropertySpecific(ObjectSchema& schema, const StringElement& element, TypeAttributes options);
-    void renderProperty(ObjectSchema& schema, const IElement& element, TypeAttributes options);
-
-    so::Object& renderSchemaSpecific(so::Object& schema, const ArrayElement& element, TypeAttributes options);
-    so::Object& renderSchemaSpecific(so::Object& schema, const BooleanElement& element, TypeAttributes options);
-    so::Object& renderSchemaSpecific(so::Object& schema, const EnumElement& element, TypeAttributes options);
-    so::Object& renderSchemaSpecific(so::Object& schema, const ExtendElement& element, TypeAttributes options);
-    so::Object& renderSchemaSpecific(so::Object& schema, const HolderElement& element, TypeAttributes options);
-    so::Object& renderSchemaSpecific(so::Object& schema, const MemberElement& element, TypeAttributes options);
-    so::Object& renderSchemaSpecific(so::Object& schema, const NullElement& element, TypeAttributes options);
-    so::Object& renderSchemaSpecific(so::Object& schema, const NumberElement& element, TypeAttributes options);
-    so::Object& renderSchemaSpecific(so::Object& schema, const ObjectElement& element, TypeAttributes options);
-    so::Object& renderSchemaSpecific(so::Object& schema, const OptionElement& element, TypeAttributes options);
-    so::Object& renderSchemaSpecific(so::Object& schema, const RefElement& element, TypeAttributes options);
-    so::Object& renderSchemaSpecific(so::Object& schema, const SelectElement& element, TypeAttributes options);
-    so::Object& renderSchemaSpecific(so::Object& schema, const StringElement& element, TypeAttributes options);
-    so::Object& renderSchema(so::Object& schema, const IElement& element, TypeAttributes options);
+    void renderPropertySpecific(
+        ObjectSchema& schema, const ArrayElement& element, TypeAttributes options, Definitions* definitions);
+    void renderPropertySpecific(
+        ObjectSchema& schema, const BooleanElement& element, TypeAttributes options, Definitions* definitions);
+    void renderPropertySpecific(
+        ObjectSchema& schema, const EnumElement& element, TypeAttributes options, Definitions* definitions);
+    void renderPropertySpecific(
+        ObjectSchema& schema, const ExtendElement& element, TypeAttributes options, Definitions* definitions);
+    void renderPropertySpecific(
+        ObjectSchema& schema, const HolderElement& element, TypeAttributes options, Definitions* definitions);
+    void renderPropertySpecific(
+        ObjectSchema& schema, const MemberElement& element, TypeAttributes options, Definitions* definitions);
+    void renderPropertySpecific(
+        ObjectSchema& schema, const NullElement& element, TypeAttributes options, Definitions* definitions);
+    void renderPropertySpecific(
+        ObjectSchema& schema, const NumberElement& element, TypeAttributes options, Definitions* definitions);
+    void renderPropertySpecific(
+        ObjectSchema& schema, const ObjectElement& element, TypeAttributes options, Definitions* definitions);
+    void renderPropertySpecific(
+        ObjectSchema& schema, const OptionElement& element, TypeAttributes options, Definitions* definitions);
+    void renderPropertySpecific(
+        ObjectSchema& schema, const RefElement& element, TypeAttributes options, Definitions* definitions);
+    void renderPropertySpecific(
+        ObjectSchema& schema, const SelectElement& element, TypeAttributes options, Definitions* definitions);
+    void renderPropertySpecific(
+        ObjectSchema& schema, const SourceMapElement& element, TypeAttributes options, Definitions* definitions);
+    void renderPropertySpecific(
+        ObjectSchema& schema, const StringElement& element, TypeAttributes options, Definitions* definitions);
+    void renderProperty(
+        ObjectSchema& schema, const IElement& element, TypeAttributes options, Definitions* definitions);
+
+    so::Object& renderSchemaSpecific(
+        so::Object& schema, const ArrayElement& element, TypeAttributes options, Definitions* definitions);
+    so::Object& renderSchemaSpecific(
+        so::Object& schema, const BooleanElement& element, TypeAttributes options, Definitions* definitions);
+    so::Object& renderSchemaSpecific(
+        so::Object& schema, const EnumElement& element, TypeAttributes options, Definitions* definitions);
+    so::Object& renderSchemaSpecific(
+        so::Object& schema, const ExtendElement& element, TypeAttributes options, Definitions* definitions);
+    so::Object& renderSchemaSpecific(
+        so::Object& schema, const HolderElement& element, TypeAttributes options, Definitions* definitions);
+    so::Object& renderSchemaSpecific(
+        so::Object& schema, const MemberElement& element, TypeAttributes options, Definitions* definitions);
+    so::Object& renderSchemaSpecific(
+        so::Object& schema, const NullElement& element, TypeAttributes options, Definitions* definitions);
+    so::Object& renderSchemaSpecific(
+        so::Object& schema, const NumberElement& element, TypeAttributes options, Definitions* definitions);
+    so::Object& renderSchemaSpecific(
+        so::Object& schema, const ObjectElement& element, TypeAttributes options, Definitions* definitions);
+    so::Object& renderSchemaSpecific(
+        so::Object& schema, const OptionElement& element, TypeAttributes options, Definitions* definitions);
+    so::Object& renderSchemaSpecific(
+        so::Object& schema, const RefElement& element, TypeAttributes options, Definitions* definitions);
+    so::Object& renderSchemaSpecific(
+        so::Object& schema, const SelectElement& element, TypeAttributes options, Definitions* definitions);
+    so::Object& renderSchemaSpecific(
+        so::Object& schema, const SourceMapElement& element, TypeAttributes options, Definitions* definitions);
+    so::Object& renderSchemaSpecific(
+        so::Object& schema, const StringElement& element, TypeAttributes options, Definitions* definitions);
+    so::Object& renderSchema(
+        so::Object& schema, const IElement& element, TypeAttributes options, Definitions* definitions);
+    so::Object& renderMergedSchema(
+        so::Object& schema, const IElement& element, TypeAttributes options, Definitions* definitions);
 }
 
 namespace
 {
-    so::Object makeSchema(const IElement& e, TypeAttributes options)
+    so::Object makeSchema(const IElement& e, TypeAttributes options, Definitions* definitions)
     {
         so::Object result{};
-        renderSchema(result, e, options);
+        renderSchema(result, e, options, definitions);
         return result;
     }
 } // namespace
@@ -380,22 +560,25 @@ namespace
         return schema;
     }
 
-    so::Object& renderSchemaSpecific(so::Object& s, const HolderElement& e, TypeAttributes options)
+    so::Object& renderSchemaSpecific(
+        so::Object& s, const HolderElement& e, TypeAttributes options, Definitions* definitions)
     {
         if (!e.empty() && e.get().data())
-            return renderSchema(s, *e.get().data(), passFlags(options));
+            return renderSchema(s, *e.get().data(), passFlags(options), definitions);
         return s;
     }
 
-    so::Object& renderSchemaSpecific(so::Object& s, const RefElement& e, TypeAttributes options)
+    so::Object& renderSchemaSpecific(
+        so::Object& s, const RefElement& e, TypeAttributes options, Definitions* definitions)
     {
         if (const IElement* resolved = resolve(e))
-            return renderSchema(s, *resolved, passFlags(options));
+            return renderSchema(s, *resolved, passFlags(options), definitions);
         LOG(warning) << "ignoring unresolved reference in backend";
         return s;
     }
 
-    so::Object& renderSchemaSpecific(so::Object& s, const ObjectElement& e, TypeAttributes options)
+    so::Object& renderSchemaSpecific(
+        so::Object& s, const ObjectElement& e, TypeAttributes options, Definitions* definitions)
     {
         constexpr const char* TYPE_NAME = "object";
 
@@ -411,10 +594,12 @@ namespace
             for (const auto& item : e.get()) {
                 assert(item);
                 if (options.test(FIXED_TYPE_FLAG) || options.test(FIXED_FLAG))
-                    renderProperty(
-                        result, *item, inheritOrPassFlags(options, *item) | TypeAttributes{}.set(REQUIRED_FLAG));
+                    renderProperty(result,
+                        *item,
+                        inheritOrPassFlags(options, *item) | TypeAttributes{}.set(REQUIRED_FLAG),
+                        definitions);
                 else
-                    renderProperty(result, *item, inheritOrPassFlags(options, *item));
+                    renderProperty(result, *item, inheritOrPassFlags(options, *item), definitions);
             }
         }
 
@@ -426,7 +611,8 @@ namespace
         return schema;
     }
 
-    so::Object& renderSchemaSpecific(so::Object& s, const ArrayElement& e, TypeAttributes options)
+    so::Object& renderSchemaSpecific(
+        so::Object& s, const ArrayElement& e, TypeAttributes options, Definitions* definitions)
     {
         constexpr const char* TYPE_NAME = "array";
 
@@ -441,13 +627,13 @@ namespace
                 addMaxItems(schema, 0);
             } else if (e.get().size() == 1) {
                 const auto& entry = *e.get().begin();
-                so::Object items = makeSchema(*entry, inheritOrPassFlags(options, *entry));
+                so::Object items = makeSchema(*entry, inheritOrPassFlags(options, *entry), definitions);
                 addItems(schema, std::move(items));
             } else {
                 so::Array items{};
                 for (const auto& entry : e.get()) {
                     assert(entry);
-                    so::emplace_unique(items, makeSchema(*entry, inheritOrPassFlags(options, *entry)));
+                    so::emplace_unique(items, makeSchema(*entry, inheritOrPassFlags(options, *entry), definitions));
                 }
 
                 addItems(schema, so::Object{ so::from_list{}, std::make_pair("anyOf", std::move(items)) });
@@ -459,7 +645,7 @@ namespace
             if (!e.empty())
                 for (const auto& item : e.get()) {
                     assert(item);
-                    items.data.emplace_back(makeSchema(*item, inheritOrPassFlags(options, *item)));
+                    items.data.emplace_back(makeSchema(*item, inheritOrPassFlags(options, *item), definitions));
                 }
 
             auto& schema = wrapNullable(s, options);
@@ -476,7 +662,8 @@ namespace
         return s;
     }
 
-    so::Object& renderSchemaSpecific(so::Object& schema, const EnumElement& e, TypeAttributes options)
+    so::Object& renderSchemaSpecific(
+        so::Object& schema, const EnumElement& e, TypeAttributes options, Definitions* definitions)
     {
         options = updateTypeAttributes(e, options);
 
@@ -498,7 +685,7 @@ namespace
                     if (sizeOf(*enumEntry) == cardinal{ 1 }) // schema types single value
                         so::emplace_unique(enm, generateJsonValue(*enumEntry));
                     else { // schema MAY type more values
-                        auto s = makeSchema(*enumEntry, inheritFlags(options));
+                        auto s = makeSchema(*enumEntry, inheritFlags(options), definitions);
                         if (s.data.size() == 1) {
                             const auto& key = s.data.at(0).first;
                             auto* vals = mpark::get_if<so::Array>(&s.data.at(0).second);
@@ -537,7 +724,8 @@ namespace
         return schema;
     }
 
-    so::Object& renderSchemaSpecific(so::Object& schema, const NullElement& e, TypeAttributes options)
+    so::Object& renderSchemaSpecific(
+        so::Object& schema, const NullElement& e, TypeAttributes options, Definitions* definitions)
     {
         addType(schema, "null");
         return schema;
@@ -562,7 +750,7 @@ namespace
     };
 
     template <typename E>
-    so::Object& renderSchemaPrimitive(so::Object& s, const E& e, TypeAttributes options)
+    so::Object& renderSchemaPrimitive(so::Object& s, const E& e, TypeAttributes options, Definitions* definitions)
     {
         options = updateTypeAttributes(e, options);
 
@@ -586,59 +774,172 @@ namespace
         return s;
     }
 
-    so::Object& renderSchemaSpecific(so::Object& s, const MemberElement& e, TypeAttributes options)
+    so::Object& renderSchemaSpecific(
+        so::Object& s, const MemberElement& e, TypeAttributes options, Definitions* definitions)
     {
         return errorByImpossibleSchema(s, e);
     }
 
-    so::Object& renderSchemaSpecific(so::Object& s, const OptionElement& e, TypeAttributes options)
+    so::Object& renderSchemaSpecific(
+        so::Object& s, const OptionElement& e, TypeAttributes options, Definitions* definitions)
     {
         return errorByImpossibleSchema(s, e);
     }
 
-    so::Object& renderSchemaSpecific(so::Object& s, const SelectElement& e, TypeAttributes options)
+    so::Object& renderSchemaSpecific(
+        so::Object& s, const SelectElement& e, TypeAttributes options, Definitions* definitions)
     {
         return errorByImpossibleSchema(s, e);
     }
 
-    so::Object& renderSchemaSpecific(so::Object& s, const StringElement& e, TypeAttributes options)
+    so::Object& renderSchemaSpecific(
+        so::Object& s, const SourceMapElement& e, TypeAttributes options, Definitions* definitions)
     {
-        return renderSchemaPrimitive(s, e, options);
+        return errorByImpossibleSchema(s, e);
     }
 
-    so::Object& renderSchemaSpecific(so::Object& s, const NumberElement& e, TypeAttributes options)
+    so::Object& renderSchemaSpecific(
+        so::Object& s, const StringElement& e, TypeAttributes options, Definitions* definitions)
     {
-        return renderSchemaPrimitive(s, e, options);
+        return renderSchemaPrimitive(s, e, options, definitions);
     }
 
-    so::Object& renderSchemaSpecific(so::Object& s, const BooleanElement& e, TypeAttributes options)
+    so::Object& renderSchemaSpecific(
+        so::Object& s, const NumberElement& e, TypeAttributes options, Definitions* definitions)
     {
-        return renderSchemaPrimitive(s, e, options);
+        return renderSchemaPrimitive(s, e, options, definitions);
     }
 
-    so::Object& renderSchemaSpecific(so::Object& s, const ExtendElement& e, TypeAttributes options)
+    so::Object& renderSchemaSpecific(
+        so::Object& s, const BooleanElement& e, TypeAttributes options, Definitions* definitions)
     {
+        return renderSchemaPrimitive(s, e, options, definitions);
+    }
+
+    ///
+    /// Adds the named type an expanded element directly uses to definitions,
+    ///   unless already there
+    ///
+    /// @param e    expanded element; its named type and the ancestors
+    ///             thereof precede the origin, root first
+    /// @return     name of the named type; nullptr if there is none
+    ///
+    const std::string* defineNamedType(const ExtendElement& e, Definitions& definitions)
+    {
+        const auto& inheritance = e.get();
+        if (inheritance.size() < 2)
+            return nullptr;
+
+        const auto origin = std::prev(inheritance.end());
+        const std::string* name = namedTypeOf(**std::prev(origin));
+        if (!name)
+            return nullptr;
+
+        if (definitions.index.find(*name) != definitions.index.end())
+            return name;
+
+        // registered before rendering, so circular references refer to it
+        const std::size_t position = definitions.entries.data.size();
+        definitions.index.emplace(*name, position);
+        definitions.entries.data.emplace_back(*name, so::Object{});
+        definitions.refs.emplace_back();
+
+        dsd::Extend ancestors;
+        for (auto it = inheritance.begin(); it != origin; ++it)
+            ancestors.push_back((*it)->clone());
+
+        const std::size_t rendering = definitions.rendering;
+        definitions.rendering = position;
+
+        so::Object definition{};
+        renderMergedSchema(definition, *ancestors.merge(), TypeAttributes{}, &definitions);
+        reduce(definition);
+
+        definitions.rendering = rendering;
+        definitions.entries.data.at(position).second = std::move(definition);
+
+        return name;
+    }
+
+    ///
+    /// Renders a `$ref` to the definition of a named type and records the use,
+    ///   so the definition is emitted
+    ///
+    so::Object& referNamedType(
+        so::Object& s, const std::string& name, TypeAttributes options, Definitions& definitions)
+    {
+        definitions.refer(definitions.index.at(name));
+        return addRef(wrapNullable(s, options), name);
+    }
+
+    ///
+    /// Named type of a circular reference cut off by expansion, given its
+    ///   definition is being rendered and it can be referred to
+    ///
+    const std::string* cutOffNamedType(const IElement& e, TypeAttributes options, const Definitions* definitions)
+    {
+        if (!definitions || !e.empty() || get<const ExtendElement>(&e))
+            return nullptr;
+
+        if (options.test(FIXED_FLAG) || options.test(FIXED_TYPE_FLAG))
+            return nullptr;
+
+        const std::string* name = namedTypeOf(e);
+        if (name && definitions->index.find(*name) != definitions->index.end())
+            return name;
+
+        return nullptr;
+    }
+
+    so::Object& renderSchemaSpecific(
+        so::Object& s, const ExtendElement& e, TypeAttributes options, Definitions* definitions)
+    {
+        if (definitions && !e.empty()) {
+            if (const std::string* name = defineNamedType(e, *definitions)) {
+                const bool fixed = options.test(FIXED_FLAG) || options.test(FIXED_TYPE_FLAG);
+
+                const auto& origin = *std::prev(e.get().end());
+
+                if (&e != definitions->root && !fixed && !refinesNamedType(*origin))
+                    return referNamedType(s, *name, options, *definitions);
+            }
+        }
+
         auto merged = e.get().merge();
-        renderSchema(s, *merged, options);
+        renderMergedSchema(s, *merged, options, definitions);
         return s;
     }
 
     struct RenderSchemaVisitor {
         so::Object* schemaPtr;
         TypeAttributes options;
+        Definitions* definitions;
 
         template <typename ElementT>
         void operator()(const ElementT& el)
         {
-            renderSchemaSpecific(*schemaPtr, el, options);
+            renderSchemaSpecific(*schemaPtr, el, options, definitions);
         }
     };
 
-    so::Object& renderSchema(so::Object& schema, const IElement& e, TypeAttributes options)
+    so::Object& renderSchema(so::Object& schema, const IElement& e, TypeAttributes options, Definitions* definitions)
     {
         LOG(debug) << "rendering `" << e.element() << "` element to JSON Schema";
 
-        refract::visit(e, RenderSchemaVisitor{ &schema, options });
+        if (const std::string* name = cutOffNamedType(e, options, definitions))
+            return referNamedType(schema, *name, options, *definitions);
+
+        refract::visit(e, RenderSchemaVisitor{ &schema, options, definitions });
+        return schema;
+    }
+
+    // Merged elements keep meta `ref`, they are never cut off references
+    so::Object& renderMergedSchema(
+        so::Object& schema, const IElement& e, TypeAttributes options, Definitions* definitions)
+    {
+        LOG(debug) << "rendering merged `" << e.element() << "` element to JSON Schema";
+
+        refract::visit(e, RenderSchemaVisitor{ &schema, options, definitions });
         return schema;
     }
 } // namespace
@@ -651,42 +952,48 @@ namespace
         LOG(error) << "skipping invalid property element: " << element.element();
     }
 
-    void renderPropertySpecific(ObjectSchema&, const ArrayElement& element, TypeAttributes)
+    void renderPropertySpecific(ObjectSchema&, const ArrayElement& element, TypeAttributes, Definitions*)
+    {
+        errorButSkipProperty(element);
+    }
+
+    void renderPropertySpecific(ObjectSchema&, const BooleanElement& element, TypeAttributes, Definitions*)
     {
         errorButSkipProperty(element);
     }
 
-    void renderPropertySpecific(ObjectSchema&, const BooleanElement& element, TypeAttributes)
+    void renderPropertySpecific(ObjectSchema&, const EnumElement& element, TypeAttributes, Definitions*)
     {
         errorButSkipProperty(element);
     }
 
-    void renderPropertySpecific(ObjectSchema&, const EnumElement& element, TypeAttributes)
+    void renderPropertySpecific(ObjectSchema&, const NullElement& element, TypeAttributes, Definitions*)
     {
         errorButSkipProperty(element);
     }
 
-    void renderPropertySpecific(ObjectSchema&, const NullElement& element, TypeAttributes)
+    void renderPropertySpecific(ObjectSchema&, const SourceMapElement& element, TypeAttributes, Definitions*)
     {
         errorButSkipProperty(element);
     }
 
-    void renderPropertySpecific(ObjectSchema&, const NumberElement& element, TypeAttributes)
+    void renderPropertySpecific(ObjectSchema&, const NumberElement& element, TypeAttributes, Definitions*)
     {
         errorButSkipProperty(element);
     }
 
-    void renderPropertySpecific(ObjectSchema&, const StringElement& element, TypeAttributes)
+    void renderPropertySpecific(ObjectSchema&, const StringElement& element, TypeAttributes, Definitions*)
     {
         errorButSkipProperty(element);
     }
 
-    void renderPropertySpecific(ObjectSchema&, const OptionElement& element, TypeAttributes)
+    void renderPropertySpecific(ObjectSchema&, const OptionElement& element, TypeAttributes, Definitions*)
     {
         errorButSkipProperty(element);
     }
 
-    void renderPropertySpecific(ObjectSchema& s, const MemberElement& e, TypeAttributes options)
+    void renderPropertySpecific(
+        ObjectSchema& s, const MemberElement& e, TypeAttributes options, Definitions* definitions)
     {
         if (hasFixedTypeAttr(e))
             options.set(FIXED_FLAG);
@@ -718,13 +1025,13 @@ namespace
 
                 emplace_unique(s.patternProperties, //
                     renderPattern(*strKey, passFlags(options)),
-                    makeSchema(*v, passFlags(options)));
+                    makeSchema(*v, passFlags(options), definitions));
 
             } else if (const auto& strKey = get<const StringElement>(k)) {
 
                 emplace_unique(s.patternProperties, //
                     renderPattern(*strKey, passFlags(options)),
-                    makeSchema(*v, passFlags(options)));
+                    makeSchema(*v, passFlags(options), definitions));
 
             } else {
                 LOG(error) << "Unexpected element type in Member Element key: " << k->element();
@@ -734,27 +1041,29 @@ namespace
         } else {
             auto strKey = key(e);
 
-            s.properties.data.emplace_back(strKey, makeSchema(*v, passFlags(options)));
+            s.properties.data.emplace_back(strKey, makeSchema(*v, passFlags(options), definitions));
 
             if (options.test(REQUIRED_FLAG))
                 s.required.data.emplace_back(so::String{ strKey });
         }
     }
 
-    void renderPropertySpecific(ObjectSchema& s, const HolderElement& e, TypeAttributes options)
+    void renderPropertySpecific(
+        ObjectSchema& s, const HolderElement& e, TypeAttributes options, Definitions* definitions)
     {
         if (!e.empty() && e.get().data())
-            renderProperty(s, *e.get().data(), passFlags(options));
+            renderProperty(s, *e.get().data(), passFlags(options), definitions);
     }
 
-    void renderPropertySpecific(ObjectSchema& s, const RefElement& e, TypeAttributes options)
+    void renderPropertySpecific(ObjectSchema& s, const RefElement& e, TypeAttributes options, Definitions* definitions)
     {
         if (const IElement* resolved = resolve(e))
-            renderProperty(s, *resolved, passFlags(options));
+            renderProperty(s, *resolved, passFlags(options), definitions);
         LOG(warning) << "ignoring unresolved reference in json schema backend";
     }
 
-    void renderPropertySpecific(ObjectSchema& s, const SelectElement& e, TypeAttributes options)
+    void renderPropertySpecific(
+        ObjectSchema& s, const SelectElement& e, TypeAttributes options, Definitions* definitions)
     {
         so::Array oneOfs{};
         for (const auto& option : e.get()) {
@@ -772,7 +1081,7 @@ namespace
             ObjectSchema optionSchema{};
             for (const auto& optionEntry : option->get()) {
                 assert(optionEntry);
-                renderProperty(optionSchema, *optionEntry, passFlags(options));
+                renderProperty(optionSchema, *optionEntry, passFlags(options), definitions);
             }
 
             oneOfs.data.emplace_back(materialize(std::move(optionSchema)));
@@ -782,7 +1091,8 @@ namespace
         s.allOf.data.emplace_back(std::move(result));
     }
 
-    void renderPropertySpecific(ObjectSchema& s, const ObjectElement& e, TypeAttributes options)
+    void renderPropertySpecific(
+        ObjectSchema& s, const ObjectElement& e, TypeAttributes options, Definitions* definitions)
     {
         if (hasFixedTypeAttr(e))
             options.set(FIXED_FLAG);
@@ -792,35 +1102,37 @@ namespace
         else
             for (const auto& item : e.get()) {
                 assert(item);
-                renderProperty(s, *item, inheritFlags(options));
+                renderProperty(s, *item, inheritFlags(options), definitions);
             }
     }
 
-    void renderPropertySpecific(ObjectSchema& s, const ExtendElement& e, TypeAttributes options)
+    void renderPropertySpecific(
+        ObjectSchema& s, const ExtendElement& e, TypeAttributes options, Definitions* definitions)
     {
         if (e.empty())
             LOG(warning) << "empty extend element in backend";
 
         auto merged = e.get().merge();
-        renderProperty(s, *merged, passFlags(options));
+        renderProperty(s, *merged, passFlags(options), definitions);
     }
 
     struct RenderPropertyVisitor {
         ObjectSchema* schemaPtr;
         TypeAttributes options;
+        Definitions* definitions;
 
         template <typename ElementT>
         void operator()(const ElementT& el)
         {
-            renderPropertySpecific(*schemaPtr, el, options);
+            renderPropertySpecific(*schemaPtr, el, options, definitions);
         }
     };
 
-    void renderProperty(ObjectSchema& s, const IElement& e, TypeAttributes options)
+    void renderProperty(ObjectSchema& s, const IElement& e, TypeAttributes options, Definitions* definitions)
     {
         LOG(debug) << "rendering property `" << e.element() << "` as JSON Schema";
 
-        refract::visit(e, RenderPropertyVisitor{ &s, options });
+        refract::visit(e, RenderPropertyVisitor{ &s, options, definitions });
     }
 } // namespace
 
@@ -886,14 +1198,27 @@ namespace
     }
 } // namespace
 
-so::Object schema::generateJsonSchema(const IElement& el)
+so::Object schema::generateJsonSchema(const IElement& el, NamedTypes namedTypes)
 {
     so::Object result{};
 
     addSchemaVersion(result);
-    renderSchema(result, el, TypeAttributes{});
 
+    if (namedTypes == NamedTypes::Inline) {
+        renderSchema(result, el, TypeAttributes{}, nullptr);
+        reduce(result);
+        return result;
+    }
+
+    Definitions definitions(&el);
+    renderSchema(result, el, TypeAttributes{}, &definitions);
+
+    // definitions are reduced one by one as they are rendered
     reduce(result);
 
+    so::Object referred = definitions.takeReferred();
+    if (!referred.data.empty())
+        result.data.emplace_back("definitions", std::move(referred));
+
     return result;
 }
@@ -17,7 +17,26 @@ namespace refract
 {
     namespace schema
     {
-        drafter::utils::so::Object generateJsonSchema(const IElement& el);
+        ///
+        /// How named types found in an expanded element are rendered
+        ///
+        enum class NamedTypes
+        {
+            Inline,     //< every use of a named type is rendered in full
+            Definitions //< named types are rendered once under `definitions`, uses refer to them by `$ref`
+        };
+
+        ///
+        /// Generate JSON Schema from an expanded data structure element
+        ///
+        /// @param el           expanded element
+        /// @param namedTypes   how named types are rendered; with `Definitions`,
+        ///                     circular references cut off by expansion become
+        ///                     `$ref`s to the named type
+        ///
+        /// @return JSON Schema draft-07
+        ///
+        drafter::utils::so::Object generateJsonSchema(const IElement& el, NamedTypes namedTypes = NamedTypes::Inline);
     }
 }
 
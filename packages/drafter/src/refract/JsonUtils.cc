@@ -23,7 +23,7 @@ so::String utils::instantiate(const dsd::String& e)
 
 so::Number utils::instantiate(const dsd::Number& e)
 {
-    return so::Number{ e.get() };
+    return e.native();
 }
 
 so::Value utils::instantiate(const dsd::Boolean& e)
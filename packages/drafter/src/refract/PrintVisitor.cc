@@ -8,6 +8,7 @@
 
 #include "PrintVisitor.h"
 
+#include <atomic>
 #include <cassert>
 #include <fstream>
 #include <iostream>
@@ -47,6 +48,15 @@ namespace refract
             return out;
         }
 
+        std::ostream& operator<<(std::ostream& out, const dsd::SourceMap& obj)
+        {
+            out << '[';
+            for (const auto& range : obj.ranges())
+                out << '[' << range.location << ", " << range.length << ']';
+            out << ']';
+            return out;
+        }
+
         template <typename ElementT>
         std::ostream& dumpContent(std::ostream& out, const ElementT& e)
         {
@@ -157,6 +167,13 @@ namespace refract
         os << '\n';
     }
 
+    void PrintVisitor::operator()(const SourceMapElement& e)
+    {
+        indented() << "- SourceMapElement ";
+        dumpContent(os, e);
+        os << '\n';
+    }
+
     void PrintVisitor::operator()(const MemberElement& e)
     {
         assert(!e.empty());
@@ -220,11 +237,12 @@ namespace refract
 
     int log_to_files(const IElement& e, const std::string& name /*= "print"*/)
     {
-        static int i = 0;
+        static std::atomic<int> counter{ 0 };
+        const int i = counter++;
         std::ofstream out(std::to_string(i) + "-" + name + ".log");
         PrintVisitor printer(0, out);
         Visit(printer, e);
-        return i++;
+        return i;
     }
 
 }; // namespace refract
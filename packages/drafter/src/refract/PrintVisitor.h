@@ -57,6 +57,7 @@ namespace refract
         void operator()(const ExtendElement& e);
         void operator()(const OptionElement& e);
         void operator()(const SelectElement& e);
+        void operator()(const SourceMapElement& e);
 
         static void Visit(const IElement& e);
     };
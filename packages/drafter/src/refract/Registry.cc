@@ -10,7 +10,7 @@
 
 #include "Element.h"
 #include "Exception.h"
-#include "TypeQueryVisitor.h"
+#include "ElementUtils.h"
 #include <algorithm>
 
 using namespace refract;
@@ -20,13 +20,13 @@ namespace
     Registry::type_map baseTypeMap()
     {
         Registry::type_map result;
-        result.emplace(std::make_pair("boolean", make_empty<BooleanElement>()));
-        result.emplace(std::make_pair("number", make_empty<NumberElement>()));
-        result.emplace(std::make_pair("string", make_empty<StringElement>()));
-        result.emplace(std::make_pair("array", make_empty<ArrayElement>()));
-        result.emplace(std::make_pair("object", make_empty<ObjectElement>()));
-        result.emplace(std::make_pair("enum", make_empty<EnumElement>()));
-        result.emplace(std::make_pair("null", make_empty<NullElement>()));
+        result.emplace(Symbol("boolean"), make_empty<BooleanElement>());
+        result.emplace(Symbol("number"), make_empty<NumberElement>());
+        result.emplace(Symbol("string"), make_empty<StringElement>());
+        result.emplace(Symbol("array"), make_empty<ArrayElement>());
+        result.emplace(Symbol("object"), make_empty<ObjectElement>());
+        result.emplace(Symbol("enum"), make_empty<EnumElement>());
+        result.emplace(Symbol("null"), make_empty<NullElement>());
         return result;
     }
 }
@@ -34,6 +34,11 @@ namespace
 Registry::Registry() : types_{baseTypeMap()} {}
 
 const IElement* refract::FindRootAncestor(const std::string& name, const Registry& registry)
+{
+    return FindRootAncestor(Symbol(name), registry);
+}
+
+const IElement* refract::FindRootAncestor(const Symbol& name, const Registry& registry)
 {
     const IElement* parent = registry.find(name);
 
@@ -60,7 +65,7 @@ namespace
             throw LogicError("Element has no ID");
         }
 
-        if (const StringElement* s = TypeQueryVisitor::as<const StringElement>(it->second.get())) {
+        if (const StringElement* s = get<const StringElement>(it->second.get())) {
             return s->get();
         }
 
@@ -69,6 +74,11 @@ namespace
 }
 
 const IElement* Registry::find(const std::string& name) const
+{
+    return find(Symbol(name));
+}
+
+const IElement* Registry::find(const Symbol& name) const
 {
     auto i = types_.find(name);
 
@@ -89,7 +99,7 @@ bool Registry::add(std::unique_ptr<IElement> element)
         throw LogicError("Element has no ID");
     }
 
-    std::string id = getElementId(*element);
+    Symbol id(getElementId(*element));
 
     if (isReserved(id)) {
         throw LogicError("You can not register a basic element");
@@ -105,6 +115,11 @@ bool Registry::add(std::unique_ptr<IElement> element)
 }
 
 bool Registry::remove(const std::string& name)
+{
+    return remove(Symbol(name));
+}
+
+bool Registry::remove(const Symbol& name)
 {
     auto i = types_.find(name);
 
@@ -8,18 +8,19 @@
 #ifndef REFRACT_REGISTRY_H
 #define REFRACT_REGISTRY_H
 
-#include <map>
+#include <unordered_map>
 #include <string>
 #include <memory>
 
 #include "ElementIfc.h"
+#include "Symbol.h"
 
 namespace refract
 {
     class Registry
     {
     public:
-        using type_map = std::map<std::string, std::unique_ptr<IElement> >;
+        using type_map = std::unordered_map<Symbol, std::unique_ptr<IElement> >;
 
     private:
         type_map types_;
@@ -29,13 +30,16 @@ namespace refract
 
     public:
         const IElement* find(const std::string& name) const;
+        const IElement* find(const Symbol& name) const;
 
         bool add(std::unique_ptr<IElement> element);
         bool remove(const std::string& name);
+        bool remove(const Symbol& name);
         void clear();
     };
 
     const IElement* FindRootAncestor(const std::string& name, const Registry& registry);
+    const IElement* FindRootAncestor(const Symbol& name, const Registry& registry);
 
 } // namespace refract
 
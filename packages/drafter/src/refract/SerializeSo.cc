@@ -33,6 +33,7 @@ namespace
     so::Value serializeContent(const dsd::Holder& e, bool renderSourceMaps);
     so::Object serializeContent(const dsd::Member& e, bool renderSourceMaps);
     so::String serializeContent(const dsd::Ref& e, bool renderSourceMaps);
+    so::Array serializeContent(const dsd::SourceMap& e, bool renderSourceMaps);
 
     struct SerializeContentVisitor {
         bool renderSourceMaps;
@@ -141,7 +142,7 @@ namespace
     so::Number serializeContent(const dsd::Number& value, bool)
     {
         LOG(debug) << "Serializing NumberElement content";
-        return so::Number{ value.get() };
+        return value.native();
     }
 
     so::Value serializeContent(const dsd::Boolean& value, bool)
@@ -196,6 +197,57 @@ namespace
         return so::String{ value.symbol() };
     }
 
+    so::Object serializeNumber(std::uint32_t value)
+    {
+        so::Object result;
+        result.data.emplace_back("element", so::String{ dsd::Number::name });
+        result.data.emplace_back("content", so::Number{ value });
+        return result;
+    }
+
+    so::Object serializeNumber(std::uint32_t value, std::uint32_t line, std::uint32_t column)
+    {
+        so::Object attributes;
+        attributes.data.emplace_back("line", serializeNumber(line));
+        attributes.data.emplace_back("column", serializeNumber(column));
+
+        so::Object result;
+        result.data.emplace_back("element", so::String{ dsd::Number::name });
+        result.data.emplace_back("attributes", std::move(attributes));
+        result.data.emplace_back("content", so::Number{ value });
+        return result;
+    }
+
+    so::Array serializeContent(const dsd::SourceMap& value, bool)
+    {
+        LOG(debug) << "Serializing SourceMapElement content";
+        so::Array result;
+
+        const auto& ranges = value.ranges();
+        const auto& positions = value.positions();
+
+        for (std::size_t i = 0; i < ranges.size(); ++i) {
+            so::Array range;
+
+            if (positions.empty()) {
+                range.data.emplace_back(serializeNumber(ranges[i].location));
+                range.data.emplace_back(serializeNumber(ranges[i].length));
+            } else {
+                const auto& position = positions[i];
+                range.data.emplace_back(
+                    serializeNumber(ranges[i].location, position.fromLine, position.fromColumn));
+                range.data.emplace_back(serializeNumber(ranges[i].length, position.toLine, position.toColumn));
+            }
+
+            so::Object rangeElement;
+            rangeElement.data.emplace_back("element", so::String{ dsd::Array::name });
+            rangeElement.data.emplace_back("content", std::move(range));
+            result.data.emplace_back(std::move(rangeElement));
+        }
+
+        return result;
+    }
+
 } // namespace
 
 so::Value serialize::renderSo(const IElement& el, bool sourceMaps)
@@ -0,0 +1,255 @@
+//
+//  refract/SerializeStream.cc
+//  librefract
+//
+//  Copyright (c) 2020 Apiary Inc. All rights reserved.
+//
+
+#include "SerializeStream.h"
+
+#include "../utils/log/Trivial.h"
+#include "../utils/so/JsonIo.h"
+#include "../utils/so/YamlIo.h"
+#include "Element.h"
+
+#include <algorithm>
+
+using namespace refract;
+using namespace serialize;
+using namespace drafter::utils;
+using namespace drafter::utils::log;
+
+namespace
+{
+    bool isRendered(const InfoElements::value_type& entry, bool renderSourceMaps)
+    {
+        return renderSourceMaps || entry.first != "sourceMap";
+    }
+
+    bool hasRendered(const InfoElements& info, bool renderSourceMaps)
+    {
+        return std::any_of(info.begin(), info.end(), [renderSourceMaps](const InfoElements::value_type& entry) {
+            return isRendered(entry, renderSourceMaps);
+        });
+    }
+
+    // Mirrors the Simple Object translation in SerializeSo.cc, emitting
+    // writer events instead of building so::Value
+    template <typename Writer>
+    struct StreamSerializer {
+        Writer& out;
+
+        void serializeAny(const IElement& e, bool renderSourceMaps)
+        {
+            out.begin_object();
+
+            out.key("element");
+            out.string(e.element());
+
+            if (hasRendered(e.meta(), renderSourceMaps)) {
+                out.key("meta");
+                serialize(e.meta(), renderSourceMaps);
+            }
+
+            const bool renderAttributeSourceMaps = renderSourceMaps || e.element() == "annotation";
+            if (hasRendered(e.attributes(), renderAttributeSourceMaps)) {
+                out.key("attributes");
+                serialize(e.attributes(), renderAttributeSourceMaps);
+            }
+
+            if (!e.empty()) {
+                out.key("content");
+                visit(e, ContentVisitor{ *this, renderSourceMaps });
+            }
+
+            out.end_object();
+        }
+
+        void serialize(const InfoElements& info, bool renderSourceMaps)
+        {
+            out.begin_object();
+            for (const auto& entry : info) {
+                assert(entry.second);
+                if (isRendered(entry, renderSourceMaps)) {
+                    out.key(entry.first);
+                    serializeAny(*entry.second, renderSourceMaps);
+                }
+            }
+            out.end_object();
+        }
+
+        template <typename ValueT>
+        void serializeListContent(const ValueT& value, bool renderSourceMaps)
+        {
+            out.begin_array();
+            for (const auto& entry : value) {
+                assert(entry);
+                serializeAny(*entry, renderSourceMaps);
+            }
+            out.end_array();
+        }
+
+        void serializeContent(const dsd::Object& value, bool renderSourceMaps)
+        {
+            serializeListContent(value, renderSourceMaps);
+        }
+
+        void serializeContent(const dsd::Array& value, bool renderSourceMaps)
+        {
+            serializeListContent(value, renderSourceMaps);
+        }
+
+        void serializeContent(const dsd::Enum& value, bool renderSourceMaps)
+        {
+            assert(value.value());
+            serializeAny(*value.value(), renderSourceMaps);
+        }
+
+        void serializeContent(const dsd::Null&, bool)
+        {
+            out.null();
+        }
+
+        void serializeContent(const dsd::String& value, bool)
+        {
+            out.string(value.get());
+        }
+
+        void serializeContent(const dsd::Number& value, bool)
+        {
+            out.number(value.native());
+        }
+
+        void serializeContent(const dsd::Boolean& value, bool)
+        {
+            out.boolean(value.get());
+        }
+
+        void serializeContent(const dsd::Extend& value, bool renderSourceMaps)
+        {
+            serializeListContent(value, renderSourceMaps);
+        }
+
+        void serializeContent(const dsd::Select& value, bool renderSourceMaps)
+        {
+            serializeListContent(value, renderSourceMaps);
+        }
+
+        void serializeContent(const dsd::Option& value, bool renderSourceMaps)
+        {
+            serializeListContent(value, renderSourceMaps);
+        }
+
+        void serializeContent(const dsd::Holder& value, bool renderSourceMaps)
+        {
+            assert(value.data());
+            serializeAny(*value.data(), renderSourceMaps);
+        }
+
+        void serializeContent(const dsd::Member& value, bool renderSourceMaps)
+        {
+            out.begin_object();
+
+            assert(value.key());
+            out.key("key");
+            serializeAny(*value.key(), renderSourceMaps);
+
+            if (const auto v = value.value()) {
+                out.key("value");
+                serializeAny(*v, renderSourceMaps);
+            }
+
+            out.end_object();
+        }
+
+        void serializeContent(const dsd::Ref& value, bool)
+        {
+            out.string(value.symbol());
+        }
+
+        void serializeNumber(std::uint32_t value)
+        {
+            out.begin_object();
+            out.key("element");
+            out.string(dsd::Number::name);
+            out.key("content");
+            out.number(std::int64_t{ value });
+            out.end_object();
+        }
+
+        void serializeNumber(std::uint32_t value, std::uint32_t line, std::uint32_t column)
+        {
+            out.begin_object();
+            out.key("element");
+            out.string(dsd::Number::name);
+            out.key("attributes");
+            out.begin_object();
+            out.key("line");
+            serializeNumber(line);
+            out.key("column");
+            serializeNumber(column);
+            out.end_object();
+            out.key("content");
+            out.number(std::int64_t{ value });
+            out.end_object();
+        }
+
+        void serializeContent(const dsd::SourceMap& value, bool)
+        {
+            const auto& ranges = value.ranges();
+            const auto& positions = value.positions();
+
+            out.begin_array();
+            for (std::size_t i = 0; i < ranges.size(); ++i) {
+                out.begin_object();
+                out.key("element");
+                out.string(dsd::Array::name);
+                out.key("content");
+                out.begin_array();
+                if (positions.empty()) {
+                    serializeNumber(ranges[i].location);
+                    serializeNumber(ranges[i].length);
+                } else {
+                    serializeNumber(ranges[i].location, positions[i].fromLine, positions[i].fromColumn);
+                    serializeNumber(ranges[i].length, positions[i].toLine, positions[i].toColumn);
+                }
+                out.end_array();
+                out.end_object();
+            }
+            out.end_array();
+        }
+
+        struct ContentVisitor {
+            StreamSerializer& serializer;
+            bool renderSourceMaps;
+
+            template <typename ElementT>
+            void operator()(const ElementT& el) const
+            {
+                serializer.serializeContent(el.get(), renderSourceMaps);
+            }
+        };
+    };
+
+    template <typename Writer>
+    void render(Writer& writer, const IElement& el, bool sourceMaps)
+    {
+        StreamSerializer<Writer>{ writer }.serializeAny(el, sourceMaps);
+    }
+} // namespace
+
+std::ostream& serialize::renderJson(std::ostream& out, const IElement& el, bool sourceMaps)
+{
+    LOG(info) << "Starting API Elements -> JSON serialization";
+    so::json_writer writer(out);
+    render(writer, el, sourceMaps);
+    return out;
+}
+
+std::ostream& serialize::renderYaml(std::ostream& out, const IElement& el, bool sourceMaps)
+{
+    LOG(info) << "Starting API Elements -> YAML serialization";
+    so::yaml_writer writer(out);
+    render(writer, el, sourceMaps);
+    return out;
+}
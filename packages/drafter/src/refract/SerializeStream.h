@@ -0,0 +1,48 @@
+//
+//  refract/SerializeStream.h
+//  librefract
+//
+//  Copyright (c) 2020 Apiary Inc. All rights reserved.
+//
+
+#ifndef REFRACT_SERIALIZESTREAM_H
+#define REFRACT_SERIALIZESTREAM_H
+
+#include <iosfwd>
+
+#include "ElementIfc.h"
+
+namespace refract
+{
+    namespace serialize
+    {
+        ///
+        /// Serialize an API Element tree as indented JSON
+        /// @note   output is identical to rendering the tree via renderSo
+        ///         and serializing it with serialize_json, but no
+        ///         intermediate Simple Object is built
+        ///
+        /// @param out          stream the JSON is written to
+        /// @param el           API Element to be serialized
+        /// @param sourceMaps   whether to print source maps; source maps on
+        ///                     Annotation Elements are always rendered
+        ///
+        std::ostream& renderJson(std::ostream& out, const IElement& el, bool sourceMaps);
+
+        ///
+        /// Serialize an API Element tree as YAML
+        /// @note   output is identical to rendering the tree via renderSo
+        ///         and serializing it with serialize_yaml, but no
+        ///         intermediate Simple Object is built
+        ///
+        /// @param out          stream the YAML is written to
+        /// @param el           API Element to be serialized
+        /// @param sourceMaps   whether to print source maps; source maps on
+        ///                     Annotation Elements are always rendered
+        ///
+        std::ostream& renderYaml(std::ostream& out, const IElement& el, bool sourceMaps);
+
+    } // namespace serialize
+} // namespace refract
+
+#endif
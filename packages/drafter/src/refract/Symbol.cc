@@ -0,0 +1,96 @@
+//
+//  refract/Symbol.cc
+//  librefract
+//
+//  Copyright (c) 2020 Apiary Inc. All rights reserved.
+//
+
+#include "Symbol.h"
+
+#include <cassert>
+#include <iterator>
+#include <ostream>
+#include <unordered_set>
+
+using namespace refract;
+
+namespace
+{
+    // Names interned up front: DSD names and info keys found on most Elements
+    constexpr const char* wellKnownNames[] = {
+        "",
+        "array",
+        "boolean",
+        "enum",
+        "extend",
+        "generic",
+        "member",
+        "null",
+        "number",
+        "object",
+        "option",
+        "ref",
+        "select",
+        "sourceMap",
+        "string",
+        "attributes",
+        "default",
+        "description",
+        "enumerations",
+        "format",
+        "id",
+        "samples",
+        "title",
+        "typeAttributes",
+        "validation",
+        "variable",
+    };
+
+    // Table of well-known names
+    //
+    // Built once, read-only afterwards, so it is looked up without locking.
+    // It is leaked so that Symbols held by static objects stay valid during
+    // static destruction.
+    const std::unordered_set<std::string>& wellKnown()
+    {
+        static const auto* table_ = new std::unordered_set<std::string>(
+            std::begin(wellKnownNames), std::end(wellKnownNames));
+        return *table_;
+    }
+
+    const std::string* findWellKnown(const std::string& str)
+    {
+        const auto& table = wellKnown();
+        auto it = table.find(str);
+        return it == table.end() ? nullptr : &*it;
+    }
+
+    std::string checked(const char* str)
+    {
+        assert(str);
+        return str;
+    }
+
+    const std::string* emptySymbol()
+    {
+        static const std::string* empty_ = findWellKnown(std::string());
+        return empty_;
+    }
+}
+
+Symbol::Symbol() noexcept : str_(emptySymbol()), owned_() {}
+
+Symbol::Symbol(const std::string& str) : str_(findWellKnown(str)), owned_()
+{
+    if (!str_) {
+        owned_ = std::make_shared<const std::string>(str);
+        str_ = owned_.get();
+    }
+}
+
+Symbol::Symbol(const char* str) : Symbol(checked(str)) {}
+
+std::ostream& refract::operator<<(std::ostream& out, const Symbol& symbol)
+{
+    return out << symbol.str();
+}
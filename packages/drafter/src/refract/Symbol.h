@@ -0,0 +1,127 @@
+//
+//  refract/Symbol.h
+//  librefract
+//
+//  Copyright (c) 2020 Apiary Inc. All rights reserved.
+//
+
+#ifndef REFRACT_SYMBOL_H
+#define REFRACT_SYMBOL_H
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <string>
+
+namespace refract
+{
+    ///
+    /// Element name or InfoElements key
+    ///
+    /// Well-known names (DSD names and common info keys) are interned once
+    /// into a read-only process-wide table; Symbols of them compare and
+    /// hash by pointer. Other names are reference counted strings shared by
+    /// copies of a Symbol and released with the last one; they compare by
+    /// content.
+    ///
+    class Symbol
+    {
+        const std::string* str_;                   //< well-known name, or owned_
+        std::shared_ptr<const std::string> owned_; //< name not well known
+
+    public:
+        ///
+        /// Symbol of the empty string
+        ///
+        Symbol() noexcept;
+
+        explicit Symbol(const std::string& str);
+        explicit Symbol(const char* str);
+
+    public:
+        const std::string& str() const noexcept
+        {
+            return *str_;
+        }
+
+        operator const std::string&() const noexcept
+        {
+            return *str_;
+        }
+
+        const char* c_str() const noexcept
+        {
+            return str_->c_str();
+        }
+
+        bool empty() const noexcept
+        {
+            return str_->empty();
+        }
+
+        std::size_t hash() const noexcept
+        {
+            return owned_ ? std::hash<std::string>{}(*str_) : std::hash<const std::string*>{}(str_);
+        }
+
+        // a well-known name is never owned, so owned Symbols only match each other
+        friend bool operator==(const Symbol& lhs, const Symbol& rhs) noexcept
+        {
+            return lhs.str_ == rhs.str_ || (lhs.owned_ && rhs.owned_ && *lhs.str_ == *rhs.str_);
+        }
+
+        friend bool operator!=(const Symbol& lhs, const Symbol& rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+    };
+
+    inline bool operator==(const Symbol& lhs, const std::string& rhs) noexcept
+    {
+        return lhs.str() == rhs;
+    }
+
+    inline bool operator==(const std::string& lhs, const Symbol& rhs) noexcept
+    {
+        return lhs == rhs.str();
+    }
+
+    inline bool operator==(const Symbol& lhs, const char* rhs) noexcept
+    {
+        return std::strcmp(lhs.c_str(), rhs) == 0;
+    }
+
+    inline bool operator==(const char* lhs, const Symbol& rhs) noexcept
+    {
+        return std::strcmp(lhs, rhs.c_str()) == 0;
+    }
+
+    template <typename T>
+    bool operator!=(const Symbol& lhs, const T& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+    template <typename T>
+    bool operator!=(const T& lhs, const Symbol& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+    std::ostream& operator<<(std::ostream& out, const Symbol& symbol);
+}
+
+namespace std
+{
+    template <>
+    struct hash<refract::Symbol> {
+        std::size_t operator()(const refract::Symbol& symbol) const noexcept
+        {
+            return symbol.hash();
+        }
+    };
+}
+
+#endif
@@ -14,15 +14,37 @@
         typeInfo = ELEMENT;                                                                                            \
     }
 
+#define ASSERT_SAME_TYPE(ELEMENT)                                                                                      \
+    static_assert(static_cast<int>(ElementType::ELEMENT) == static_cast<int>(TypeQueryVisitor::ELEMENT),                \
+        "TypeQueryVisitor::ElementType must follow ElementType");
+
 namespace refract
 {
+    ASSERT_SAME_TYPE(Null)
+    ASSERT_SAME_TYPE(Holder)
+    ASSERT_SAME_TYPE(String)
+    ASSERT_SAME_TYPE(Number)
+    ASSERT_SAME_TYPE(Boolean)
+    ASSERT_SAME_TYPE(Array)
+    ASSERT_SAME_TYPE(Member)
+    ASSERT_SAME_TYPE(Object)
+    ASSERT_SAME_TYPE(Enum)
+    ASSERT_SAME_TYPE(Ref)
+    ASSERT_SAME_TYPE(Extend)
+    ASSERT_SAME_TYPE(Option)
+    ASSERT_SAME_TYPE(Select)
+    ASSERT_SAME_TYPE(SourceMap)
+
     TypeQueryVisitor::TypeQueryVisitor() : typeInfo(Unknown) {}
 
+    TypeQueryVisitor::ElementType TypeQueryVisitor::of(const IElement& e) noexcept
+    {
+        return static_cast<ElementType>(e.type());
+    }
+
     void TypeQueryVisitor::operator()(const IElement& e)
     {
-        TypeQueryVisitor query;
-        VisitBy(e, query);
-        typeInfo = query.get();
+        typeInfo = of(e);
     }
 
     VISIT_IMPL(Null)
@@ -38,6 +60,7 @@ namespace refract
     VISIT_IMPL(Extend)
     VISIT_IMPL(Option)
     VISIT_IMPL(Select)
+    VISIT_IMPL(SourceMap)
 
     TypeQueryVisitor::ElementType TypeQueryVisitor::get() const
     {
@@ -47,3 +70,4 @@ namespace refract
 }; // namespace refract
 
 #undef VISIT_IMPL
+#undef ASSERT_SAME_TYPE
@@ -8,6 +8,7 @@
 
 #include "Utils.h"
 #include "Element.h"
+#include "ElementUtils.h"
 
 #include <algorithm>
 
@@ -21,7 +22,7 @@ namespace
         template <typename ElementT>
         bool operator()(const ElementT& lhs)
         {
-            if (auto rhsptr = dynamic_cast<const ElementT*>(&rhs)) {
+            if (auto rhsptr = get<const ElementT>(&rhs)) {
                 return                                             //
                     (lhs.empty() == rhs.empty()) &&                //
                     (lhs.attributes() == rhs.attributes()) &&      //
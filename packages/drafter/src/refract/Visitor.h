@@ -11,83 +11,127 @@
 #include "ElementFwd.h"
 #include "ElementIfc.h"
 
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
 namespace refract
 {
+    namespace visitor
+    {
+        template <typename... Elements>
+        struct element_list {
+        };
+
+        /// Elements a Visitor dispatches to, IElement being the fallback
+        using Visitable = element_list<IElement,
+            NullElement,
+            HolderElement,
+            StringElement,
+            NumberElement,
+            BooleanElement,
+            ArrayElement,
+            EnumElement,
+            MemberElement,
+            ObjectElement,
+            RefElement,
+            ExtendElement,
+            OptionElement,
+            SelectElement,
+            SourceMapElement>;
+
+        template <typename T, typename List>
+        struct index_of;
+
+        template <typename T, typename... Rest>
+        struct index_of<T, element_list<T, Rest...> > : std::integral_constant<std::size_t, 0> {
+        };
+
+        template <typename T, typename First, typename... Rest>
+        struct index_of<T, element_list<First, Rest...> >
+            : std::integral_constant<std::size_t, 1 + index_of<T, element_list<Rest...> >::value> {
+        };
 
-    struct IApply {
-        virtual void visit(const IElement& e) = 0;
-
-        virtual void visit(const NullElement& e) = 0;
-        virtual void visit(const HolderElement& e) = 0;
-        virtual void visit(const StringElement& e) = 0;
-        virtual void visit(const NumberElement& e) = 0;
-        virtual void visit(const BooleanElement& e) = 0;
-        virtual void visit(const ArrayElement& e) = 0;
-        virtual void visit(const EnumElement& e) = 0;
-        virtual void visit(const MemberElement& e) = 0;
-        virtual void visit(const ObjectElement& e) = 0;
-        virtual void visit(const RefElement& e) = 0;
-        virtual void visit(const ExtendElement& e) = 0;
-        virtual void visit(const OptionElement& e) = 0;
-        virtual void visit(const SelectElement& e) = 0;
-
-        virtual ~IApply() {}
-    };
+        template <typename T>
+        struct index_of<T, element_list<> > {
+            // T is not a visitable element; no `value` member
+        };
+    } // namespace visitor
+
+    ///
+    /// Type-erased reference to a functor accepting any Element
+    ///
+    /// Dispatches through a per-functor table of function pointers, one for
+    /// each type in visitor::Visitable. The table is static, the Visitor
+    /// itself is two pointers wide; constructing and visiting never allocate.
+    ///
+    /// The functor is referenced, it must outlive the Visitor.
+    ///
+    class Visitor
+    {
+        union Target {
+            void* object;
+            void (*function)();
+        };
 
-#ifndef APPLY_VISIT_IMPL
-#define APPLY_VISIT_IMPL(ELEMENT)                                                                                      \
-    virtual void visit(const ELEMENT& e)                                                                               \
-    {                                                                                                                  \
-        impl(e);                                                                                                       \
-    }
-#endif
-
-    template <typename Impl>
-    struct ApplyImpl : public IApply {
-
-        Impl& impl;
-        ApplyImpl(Impl& impl) : impl(impl) {}
-
-        APPLY_VISIT_IMPL(IElement)
-        APPLY_VISIT_IMPL(NullElement)
-        APPLY_VISIT_IMPL(HolderElement)
-        APPLY_VISIT_IMPL(StringElement)
-        APPLY_VISIT_IMPL(NumberElement)
-        APPLY_VISIT_IMPL(BooleanElement)
-        APPLY_VISIT_IMPL(ArrayElement)
-        APPLY_VISIT_IMPL(EnumElement)
-        APPLY_VISIT_IMPL(MemberElement)
-        APPLY_VISIT_IMPL(ObjectElement)
-        APPLY_VISIT_IMPL(RefElement)
-        APPLY_VISIT_IMPL(ExtendElement)
-        APPLY_VISIT_IMPL(OptionElement)
-        APPLY_VISIT_IMPL(SelectElement)
-
-        virtual ~ApplyImpl() {}
-    };
+        using Dispatch = void (*)(Target, const IElement&);
 
-#undef APPLY_VISIT_IMPL
+        Target target;
+        const Dispatch* table;
 
-    class Visitor
-    {
+        template <typename Functor>
+        static Target erase(Functor& functor, std::false_type)
+        {
+            Target t;
+            t.object = const_cast<void*>(static_cast<const void*>(std::addressof(functor)));
+            return t;
+        }
 
-    private:
-        IApply* apply;
+        template <typename Functor>
+        static Target erase(Functor& functor, std::true_type)
+        {
+            Target t;
+            t.function = reinterpret_cast<void (*)()>(&functor);
+            return t;
+        }
 
-    public:
         template <typename Functor>
-        Visitor(Functor& functor) : apply(new ApplyImpl<Functor>(functor))
+        static Functor& restore(Target t, std::false_type)
+        {
+            return *static_cast<Functor*>(t.object);
+        }
+
+        template <typename Functor>
+        static Functor& restore(Target t, std::true_type)
+        {
+            return *reinterpret_cast<Functor*>(t.function);
+        }
+
+        template <typename Functor, typename Element>
+        static void dispatch(Target t, const IElement& e)
         {
+            restore<Functor>(t, std::is_function<Functor>{})(static_cast<const Element&>(e));
         }
-        virtual ~Visitor()
+
+        template <typename Functor, typename... Elements>
+        static const Dispatch* tableOf(visitor::element_list<Elements...>)
+        {
+            static const Dispatch table[] = { &dispatch<Functor, Elements>... };
+            return table;
+        }
+
+    public:
+        template <typename Functor,
+            typename = typename std::enable_if<!std::is_same<typename std::decay<Functor>::type, Visitor>::value>::type>
+        Visitor(Functor& functor)
+            : target(erase(functor, std::is_function<Functor>{})), table(tableOf<Functor>(visitor::Visitable{}))
         {
-            delete apply;
         }
 
         template <typename T>
         void visit(const T& e)
         {
-            apply->visit(e);
+            table[visitor::index_of<T, visitor::Visitable>::value](target, e);
         }
     };
 
@@ -18,7 +18,7 @@ const StringElement* refract::GetDescription(const IElement& e)
         return nullptr;
     }
 
-    return TypeQueryVisitor::as<const StringElement>(i->second.get());
+    return get<const StringElement>(i->second.get());
 }
 
 std::string refract::GetKeyAsString(const MemberElement& e)
@@ -30,14 +30,14 @@ std::string refract::GetKeyAsString(const MemberElement& e)
         return {};
     }
 
-    if (auto str = TypeQueryVisitor::as<const StringElement>(element)) {
+    if (auto str = get<const StringElement>(element)) {
         return str->get();
     }
 
-    if (auto ext = TypeQueryVisitor::as<const ExtendElement>(element)) {
+    if (auto ext = get<const ExtendElement>(element)) {
         auto merged = ext->get().merge();
 
-        if (auto str = TypeQueryVisitor::as<const StringElement>(merged.get())) {
+        if (auto str = get<const StringElement>(merged.get())) {
 
             std::string result{};
 
@@ -73,9 +73,7 @@ MemberElement* refract::FindMemberByKey(const ObjectElement& e, const std::strin
 
 bool refract::IsLiteral(const IElement& e)
 {
-    TypeQueryVisitor query;
-    VisitBy(e, query);
-    auto elementType = query.get();
+    auto elementType = TypeQueryVisitor::of(e);
 
     if (elementType == TypeQueryVisitor::Null)
         return false;
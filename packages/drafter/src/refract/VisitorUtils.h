@@ -12,6 +12,7 @@
 #include "Visitor.h"
 
 #include "TypeQueryVisitor.h"
+#include "ElementUtils.h"
 #include "ComparableVisitor.h"
 
 // this will be removed, refract should not contain reference to other libraries
@@ -28,14 +29,14 @@ namespace refract
             return false;
         }
 
-        auto attrs = TypeQueryVisitor::as<const ArrayElement>(ta->second.get());
+        auto attrs = get<const ArrayElement>(ta->second.get());
 
         if (!attrs) {
             return false;
         }
 
         for (const auto& value : attrs->get()) {
-            auto attr = TypeQueryVisitor::as<const StringElement>(value.get());
+            auto attr = get<const StringElement>(value.get());
             if (!attr) {
                 continue;
             }
@@ -56,7 +57,7 @@ namespace refract
             return false;
         }
 
-        auto b = TypeQueryVisitor::as<const BooleanElement>(var->second.get());
+        auto b = get<const BooleanElement>(var->second.get());
         return b ? static_cast<bool>(b->get()) : false;
     }
 
@@ -69,7 +70,7 @@ namespace refract
             return NULL;
         }
 
-        return TypeQueryVisitor::as<const T>(dflt->second.get());
+        return get<const T>(dflt->second.get());
     }
 
     template <typename T>
@@ -81,13 +82,13 @@ namespace refract
             return nullptr;
         }
 
-        auto a = TypeQueryVisitor::as<ArrayElement>(i->second.get());
+        auto a = get<ArrayElement>(i->second.get());
 
         if (!a || a->get().empty()) {
             return nullptr;
         }
 
-        return TypeQueryVisitor::as<T>(a->get().begin()->get());
+        return get<T>(a->get().begin()->get());
     }
 
     template <typename T, typename R = typename T::ValueType>
@@ -153,7 +154,7 @@ namespace refract
                         }
 
                         // We need to hadle Enum individualy because of attr["enumerations"]
-                        if (const EnumElement* val = TypeQueryVisitor::as<const EnumElement>(item.get())) {
+                        if (const EnumElement* val = get<const EnumElement>(item.get())) {
                             auto ret = operator()(*val);
                             if (ret) {
                                 return ret;
@@ -180,7 +181,7 @@ namespace refract
                 return nullptr;
             }
 
-            return TypeQueryVisitor::as<const ArrayElement>(i->second.get());
+            return get<const ArrayElement>(i->second.get());
         }
     };
 
@@ -188,7 +189,7 @@ namespace refract
     template <typename T>
     void CheckMixinParent(const refract::IElement* element)
     {
-        const T* resolved = TypeQueryVisitor::as<T>(element);
+        const T* resolved = get<T>(element);
 
         if (!resolved) {
             throw snowcrash::Error(
@@ -210,7 +211,7 @@ namespace refract
 
         const IElement* foundValue = found->second.get();
 
-        const ExtendElement* extended = TypeQueryVisitor::as<const ExtendElement>(foundValue);
+        const ExtendElement* extended = get<const ExtendElement>(foundValue);
 
         if (!extended) {
 
@@ -238,7 +239,7 @@ namespace refract
             return nullptr;
         }
 
-        return TypeQueryVisitor::as<T>(i->second.get());
+        return get<T>(i->second.get());
     }
 
     std::string GetKeyAsString(const MemberElement& e);
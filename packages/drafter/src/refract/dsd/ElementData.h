@@ -21,6 +21,7 @@
 #include "Option.h"
 #include "Ref.h"
 #include "Select.h"
+#include "SourceMap.h"
 #include "String.h"
 
 namespace refract
@@ -10,11 +10,14 @@
 
 #include <algorithm>
 #include <cassert>
+#include <deque>
 #include <map>
 #include <set>
+#include <unordered_map>
 
 #include "../Exception.h"
 #include "../Element.h"
+#include "../ElementUtils.h"
 #include "../InfoElements.h"
 #include "../TypeQueryVisitor.h"
 #include "../Utils.h"
@@ -82,75 +85,133 @@ namespace
         }
     };
 
+    ///
+    /// Positions of Object entries by member key and by mixin symbol
+    ///
+    /// Positions of each key are kept ascending, so the front is the first
+    /// match. Entries outdated by replacing a Select are dropped on lookup.
+    ///
+    class ObjectIndex
+    {
+        using positions = std::deque<std::size_t>;
+
+        const dsd::Object& object_;
+        std::unordered_map<std::string, positions> members_;
+        std::unordered_map<std::string, positions> refs_;
+
+        static const std::string* memberKey(const IElement* e)
+        {
+            if (auto member = get<const MemberElement>(e)) {
+                auto key = get<const StringElement>(member->get().key());
+                assert(key);
+                return &key->get().get();
+            }
+            return nullptr;
+        }
+
+        // Mixins are matched by symbol; an empty Ref has none
+        static const RefElement* mixinRef(const IElement* e)
+        {
+            auto ref = get<const RefElement>(e);
+            return ref && !ref->empty() ? ref : nullptr;
+        }
+
+        template <typename Functor>
+        static void forEachKey(const IElement& e, Functor f)
+        {
+            if (auto key = memberKey(&e)) {
+                f(*key);
+            } else if (auto select = get<const SelectElement>(&e)) {
+                for (const auto& option : select->get())
+                    for (const auto& optEl : option->get())
+                        if (auto key = memberKey(optEl.get()))
+                            f(*key);
+            }
+        }
+
+        bool holdsKey(std::size_t position, const std::string& key) const
+        {
+            bool result = false;
+            forEachKey(*object_.begin()[position], [&result, &key](const std::string& k) { result |= (k == key); });
+            return result;
+        }
+
+        bool holdsRef(std::size_t position, const std::string& symbol) const
+        {
+            auto ref = mixinRef(object_.begin()[position].get());
+            return ref && ref->get().symbol() == symbol;
+        }
+
+    public:
+        explicit ObjectIndex(const dsd::Object& object) : object_(object)
+        {
+            for (std::size_t i = 0; i < object_.size(); ++i)
+                add(i);
+        }
+
+        void add(std::size_t position)
+        {
+            const IElement& e = *object_.begin()[position];
+
+            forEachKey(e, [this, position](const std::string& key) {
+                auto& found = members_[key];
+                if (found.empty() || found.back() != position)
+                    found.push_back(position);
+            });
+
+            if (auto ref = mixinRef(&e))
+                refs_[ref->get().symbol()].push_back(position);
+        }
+
+        ///
+        /// Find the position of the first entry matching a merged element
+        ///
+        /// @returns the position or the size of the object iff none matches
+        ///
+        std::size_t find(const IElement& merge)
+        {
+            if (auto key = memberKey(&merge)) {
+                auto it = members_.find(*key);
+                if (it != members_.end()) {
+                    while (!it->second.empty() && !holdsKey(it->second.front(), *key))
+                        it->second.pop_front();
+                    if (!it->second.empty())
+                        return it->second.front();
+                }
+            } else if (auto ref = mixinRef(&merge)) {
+                auto it = refs_.find(ref->get().symbol());
+                if (it != refs_.end()) {
+                    while (!it->second.empty() && !holdsRef(it->second.front(), ref->get().symbol()))
+                        it->second.pop_front();
+                    if (!it->second.empty())
+                        return it->second.front();
+                }
+            }
+            return object_.size();
+        }
+    };
+
     template <>
     struct ValueMerge<ObjectElement, true> {
 
         void operator()(ObjectElement& value, const ObjectElement& merge) const
         {
             if (!merge.empty()) {
+                if (value.empty())
+                    value.set();
+
+                auto& members = value.get();
+                ObjectIndex index(members);
+
                 for (const auto& m : merge.get()) {
-                    if (value.empty())
-                        value.set();
-                    auto valueMatch = [&value, &m]() {
-                        if (auto mergeMember = TypeQueryVisitor::as<const MemberElement>(m.get())) {
-                            assert(mergeMember);
-
-                            auto mergeKey = TypeQueryVisitor::as<const StringElement>(mergeMember->get().key());
-                            assert(mergeKey);
-
-                            return std::find_if(
-                                value.get().begin(), value.get().end(), [mergeKey](const std::unique_ptr<IElement>& e) {
-                                    if (auto valueMember = TypeQueryVisitor::as<const MemberElement>(e.get())) {
-                                        auto valueKey
-                                            = TypeQueryVisitor::as<const StringElement>(valueMember->get().key());
-                                        assert(valueKey);
-
-                                        return mergeKey->get() == valueKey->get();
-                                    }
-
-                                    if (auto valueSelect = TypeQueryVisitor::as<const SelectElement>(e.get())) {
-                                        return valueSelect->get().end()
-                                            != std::find_if(valueSelect->get().begin(),
-                                                   valueSelect->get().end(),
-                                                   [mergeKey](const std::unique_ptr<OptionElement>& option) {
-                                                       return option->get().end()
-                                                           != std::find_if(option->get().begin(),
-                                                                  option->get().end(),
-                                                                  [mergeKey](const std::unique_ptr<IElement>& optEl) {
-                                                                      if (auto optElMember
-                                                                          = TypeQueryVisitor::as<const MemberElement>(
-                                                                              optEl.get())) {
-                                                                          auto optElMemberKey = TypeQueryVisitor::as<
-                                                                              const StringElement>(
-                                                                              optElMember->get().key());
-                                                                          assert(optElMemberKey);
-                                                                          return optElMemberKey->get()
-                                                                              == mergeKey->get();
-                                                                      }
-                                                                      return false;
-                                                                  });
-                                                   });
-                                    }
-
-                                    return false;
-                                });
-                        } else if (auto mergeRef = TypeQueryVisitor::as<const RefElement>(m.get())) {
-                            return std::find_if(
-                                value.get().begin(), value.get().end(), [mergeRef](const std::unique_ptr<IElement>& e) {
-                                    if (auto valueRef = TypeQueryVisitor::as<const RefElement>(e.get()))
-                                        return mergeRef->get() == valueRef->get();
-                                    else
-                                        return false;
-                                });
-                        } else {
-                            return value.get().end();
-                        }
-                    }();
+                    const std::size_t position = index.find(*m);
 
-                    if (valueMatch == value.get().end()) {
-                        value.get().push_back(clone(*m));
+                    if (position == members.size()) {
+                        members.push_back(clone(*m));
+                        index.add(position);
                     } else {
-                        value.get().insert(value.get().erase(valueMatch), clone(*m));
+                        // a replacement keeps the key it was found by
+                        members.insert(members.erase(members.begin() + position), clone(*m));
                     }
                 }
             }
@@ -174,8 +235,8 @@ namespace
     struct ElementMerge {
         void operator()(IElement& target, const IElement& append) const noexcept
         {
-            assert(TypeQueryVisitor::as<const T>(&target));
-            assert(TypeQueryVisitor::as<const T>(&append));
+            assert(get<const T>(&target));
+            assert(get<const T>(&append));
 
             InfoMerge<SkipMetaKeywords>{}(target.meta(), append.meta());
             InfoMerge<SkipNothing>{}(target.attributes(), append.attributes());
@@ -201,12 +262,29 @@ namespace
         }
     };
 
+    // Content of primitive enumerations; equal elements share a key
+    std::string enumKey(const IElement& e)
+    {
+        std::string key(1, static_cast<char>(e.type()));
+        if (e.empty())
+            return key;
+
+        if (auto s = get<const StringElement>(&e))
+            key += s->get().get();
+        else if (auto n = get<const NumberElement>(&e))
+            drafter::utils::so::append_number(key, n->get().native());
+        else if (auto b = get<const BooleanElement>(&e))
+            key += b->get().get() ? "1" : "0";
+
+        return key;
+    }
+
     template <>
     struct ElementMerge<EnumElement> {
         void operator()(IElement& target, const IElement& append) const noexcept
         {
-            assert(TypeQueryVisitor::as<const EnumElement>(&target));
-            assert(TypeQueryVisitor::as<const EnumElement>(&append));
+            assert(get<const EnumElement>(&target));
+            assert(get<const EnumElement>(&append));
 
             InfoMerge<SkipMetaKeywords>{}(target.meta(), append.meta());
             InfoMerge<SkipEnumerations>{}(target.attributes(), append.attributes());
@@ -215,7 +293,7 @@ namespace
             auto append_enums_it = append.attributes().find("enumerations");
 
             if (append_enums_it != append.attributes().end()) {
-                auto append_enums = TypeQueryVisitor::as<const ArrayElement>(append_enums_it->second.get());
+                auto append_enums = get<const ArrayElement>(append_enums_it->second.get());
                 assert(append_enums);
 
                 assert(!append_enums->empty());
@@ -223,21 +301,32 @@ namespace
                     if (target_enums_it == target.attributes().end()) {
                         target.attributes().set("enumerations", clone(*append_enums));
                     } else {
-                        auto target_enums = TypeQueryVisitor::as<ArrayElement>(target_enums_it->second.get());
+                        auto target_enums = get<ArrayElement>(target_enums_it->second.get());
                         assert(target_enums);
 
+                        // removed enumerations leave empty slots, compacted once all are merged
+                        auto& slots = target_enums->get();
+                        std::unordered_map<std::string, std::vector<std::size_t> > index;
+                        for (std::size_t i = 0; i < slots.size(); ++i)
+                            index[enumKey(*slots.begin()[i])].push_back(i);
+
                         for (const auto& append_enum : append_enums->get()) {
+                            auto& candidates = index[enumKey(*append_enum)];
                             auto it = std::find_if( //
-                                target_enums->get().begin(),
-                                target_enums->get().end(),
-                                [&append_enum](const std::unique_ptr<IElement>& target_enum) {
-                                    return visit(*target_enum, TypeEqual{ *append_enum });
+                                candidates.begin(),
+                                candidates.end(),
+                                [&slots, &append_enum](std::size_t i) {
+                                    return visit(*slots.begin()[i], TypeEqual{ *append_enum });
                                 });
-                            if (target_enums->get().end() != it) {
-                                target_enums->get().erase(it);
+                            if (candidates.end() != it) {
+                                slots.begin()[*it].reset();
+                                candidates.erase(it);
                             }
-                            target_enums->get().push_back(clone(*append_enum));
+                            candidates.push_back(slots.size());
+                            slots.push_back(clone(*append_enum));
                         }
+
+                        slots.erase(std::remove(slots.begin(), slots.end(), nullptr), slots.end());
                     }
                 }
             }
@@ -264,17 +353,11 @@ namespace
 
             if (!result) {
                 result = e->clone();
-
-                TypeQueryVisitor type;
-                Visit(type, *result);
-                base = type.get();
+                base = TypeQueryVisitor::of(*result);
                 return;
             }
 
-            TypeQueryVisitor type;
-            VisitBy(*e, type);
-
-            if (type.get() != base) {
+            if (TypeQueryVisitor::of(*e) != base) {
                 throw refract::LogicError("Can not merge different types of elements");
             }
 
@@ -11,8 +11,11 @@
 #include "Traits.h"
 #include "../../utils/log/Trivial.h"
 
+#include <cstdlib>
+
 using namespace refract;
 using namespace dsd;
+using namespace drafter::utils;
 using namespace drafter::utils::log;
 
 const char* Number::name = "number";
@@ -31,25 +34,50 @@ static_assert(!supports_merge<Number>::value, "");
 static_assert(!is_iterable<Number>::value, "");
 static_assert(!is_pair<Number>::value, "");
 
-Number::Number(std::string v) noexcept : value_(v) {}
+Number::Number(std::string v) noexcept : value_(std::move(v)) {}
+
+std::string Number::get() const
+{
+    return to_string(value_);
+}
 
-const std::string& Number::get() const noexcept
+const so::Number& Number::native() const noexcept
 {
     return value_;
 }
 
+namespace
+{
+    struct integer_conversion final {
+        std::int64_t operator()(std::int64_t value) const noexcept
+        {
+            return value;
+        }
+
+        std::int64_t operator()(double value) const noexcept
+        {
+            return static_cast<std::int64_t>(value);
+        }
+
+        std::int64_t operator()(const std::string& value) const noexcept
+        {
+            char* end = nullptr;
+            std::int64_t result = std::strtoll(value.c_str(), &end, 10);
+            if (*end != '\0')
+                LOG(warning) << "dsd::Number to int; dropped trailing `" << end << "`";
+            return result;
+        }
+    };
+} // namespace
+
 Number::operator std::int64_t() const noexcept
 {
-    std::string::size_type idx;
-    std::int64_t result = std::stoi(value_, &idx);
-    if (idx < value_.size())
-        LOG(warning) << "dsd::Number to int; dropped trailing `" << value_.substr(idx) << "`";
-    return result;
+    return mpark::visit(integer_conversion{}, value_.data);
 }
 
 bool dsd::operator==(const Number& lhs, const Number& rhs) noexcept
 {
-    return lhs.get() == rhs.get();
+    return lhs.native() == rhs.native();
 }
 
 bool dsd::operator!=(const Number& lhs, const Number& rhs) noexcept
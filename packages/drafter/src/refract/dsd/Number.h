@@ -13,6 +13,8 @@
 #include <cstdint>
 #include <type_traits>
 
+#include "../../utils/so/Value.h"
+
 namespace refract
 {
     namespace dsd
@@ -23,9 +25,12 @@ namespace refract
         /// @remark Defined by its value
         /// TODO move value to attributes and leave this defined by its type
         ///
+        /// The value is held natively and rendered to text on demand;
+        /// literals are kept verbatim.
+        ///
         class Number final
         {
-            std::string value_ = "0"; //< value
+            drafter::utils::so::Number value_; //< value
 
         public:
             static const char* name; //< syntactical name of the DSD
@@ -37,23 +42,31 @@ namespace refract
             Number() = default;
 
             ///
-            /// Initialize a Number DSD from a value
+            /// Initialize a Number DSD from a literal
             ///
-            /// @value  value to be consumed
+            /// @value  literal to be consumed verbatim
             ///
             explicit Number(std::string v) noexcept;
 
+            ///
+            /// Initialize a Number DSD from an integer
+            ///
             template <typename N, typename = typename std::enable_if<std::is_integral<N>::value>::type>
-            explicit Number(N v) noexcept : value_(std::to_string(v))
+            explicit Number(N v) noexcept : value_(v)
             {
             }
 
             ///
-            /// Query the value of this Number DSD
+            /// Render the value of this Number DSD
+            ///
+            /// @returns the value as text
+            ///
+            std::string get() const;
+
             ///
-            /// @returns the value
+            /// Query the native value of this Number DSD
             ///
-            const std::string& get() const noexcept;
+            const drafter::utils::so::Number& native() const noexcept;
 
             ///
             /// Parse this Number DSD as an integer
@@ -0,0 +1,66 @@
+//
+//  refract/dsd/SourceMap.cc
+//  librefract
+//
+//  Copyright (c) 2020 Apiary Inc. All rights reserved.
+//
+
+#include "SourceMap.h"
+
+#include "Traits.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace refract;
+using namespace dsd;
+
+const char* SourceMap::name = "sourceMap";
+
+static_assert(!supports_erase<SourceMap>::value, "");
+static_assert(!supports_empty<SourceMap>::value, "");
+static_assert(!supports_insert<SourceMap>::value, "");
+static_assert(!supports_push_back<SourceMap>::value, "");
+static_assert(!supports_begin<SourceMap>::value, "");
+static_assert(!supports_end<SourceMap>::value, "");
+static_assert(!supports_size<SourceMap>::value, "");
+static_assert(!supports_key<SourceMap>::value, "");
+static_assert(!supports_value<SourceMap>::value, "");
+static_assert(!supports_merge<SourceMap>::value, "");
+static_assert(!is_iterable<SourceMap>::value, "");
+static_assert(!is_pair<SourceMap>::value, "");
+
+SourceMap::SourceMap(std::vector<Range> ranges) noexcept : ranges_(std::move(ranges)) {}
+
+SourceMap::SourceMap(std::vector<Range> ranges, std::vector<Position> positions) noexcept
+    : ranges_(std::move(ranges)), positions_(std::move(positions))
+{
+    assert(positions_.empty() || positions_.size() == ranges_.size());
+}
+
+bool dsd::operator==(const SourceMap& lhs, const SourceMap& rhs) noexcept
+{
+    const auto& l = lhs.ranges();
+    const auto& r = rhs.ranges();
+
+    if (l.size() != r.size() || lhs.positions().size() != rhs.positions().size())
+        return false;
+
+    if (!std::equal(l.begin(), l.end(), r.begin(), [](const SourceMap::Range& a, const SourceMap::Range& b) {
+            return a.location == b.location && a.length == b.length;
+        }))
+        return false;
+
+    return std::equal(lhs.positions().begin(),
+        lhs.positions().end(),
+        rhs.positions().begin(),
+        [](const SourceMap::Position& a, const SourceMap::Position& b) {
+            return a.fromLine == b.fromLine && a.fromColumn == b.fromColumn && a.toLine == b.toLine
+                && a.toColumn == b.toColumn;
+        });
+}
+
+bool dsd::operator!=(const SourceMap& lhs, const SourceMap& rhs) noexcept
+{
+    return !(lhs == rhs);
+}
@@ -0,0 +1,104 @@
+//
+//  refract/dsd/SourceMap.h
+//  librefract
+//
+//  Copyright (c) 2020 Apiary Inc. All rights reserved.
+//
+
+#ifndef REFRACT_DSD_SOURCEMAP_H
+#define REFRACT_DSD_SOURCEMAP_H
+
+#include <cstdint>
+#include <vector>
+
+namespace refract
+{
+    namespace dsd
+    {
+        ///
+        /// Data structure definition (DSD) of a Refract Source Map Element
+        ///
+        /// @remark Defined by a sequence of character ranges in the source,
+        ///     optionally with their lines and columns
+        ///
+        /// Ranges are held as packed integers. Serializers expand them to the
+        /// API Elements representation, an array of `array[number, number]`
+        /// with `line` and `column` attributes on the numbers if positions
+        /// are given.
+        ///
+        /// Offsets, lengths, lines and columns are 32 bit; values past
+        /// 4 GiB (or 2^32 - 1 lines) saturate at 2^32 - 1.
+        ///
+        class SourceMap final
+        {
+        public:
+            static const char* name; //< syntactical name of the DSD
+
+            ///
+            /// Range of characters in the source
+            ///
+            struct Range {
+                std::uint32_t location; //< offset of the first character
+                std::uint32_t length;   //< number of characters
+            };
+
+            ///
+            /// Lines and columns a Range spans
+            ///
+            struct Position {
+                std::uint32_t fromLine;
+                std::uint32_t fromColumn;
+                std::uint32_t toLine;
+                std::uint32_t toColumn;
+            };
+
+        private:
+            std::vector<Range> ranges_ = {};       //< character ranges
+            std::vector<Position> positions_ = {}; //< empty, or one for each range
+
+        public:
+            ///
+            /// Initialize a Source Map DSD without ranges
+            ///
+            SourceMap() = default;
+
+            ///
+            /// Initialize a Source Map DSD from character ranges
+            ///
+            /// @param ranges   ranges to be consumed
+            ///
+            explicit SourceMap(std::vector<Range> ranges) noexcept;
+
+            ///
+            /// Initialize a Source Map DSD from character ranges and their positions
+            ///
+            /// @param ranges       ranges to be consumed
+            /// @param positions    positions to be consumed, one for each range
+            ///
+            SourceMap(std::vector<Range> ranges, std::vector<Position> positions) noexcept;
+
+            ///
+            /// Query character ranges of this Source Map DSD
+            ///
+            const std::vector<Range>& ranges() const noexcept
+            {
+                return ranges_;
+            }
+
+            ///
+            /// Query positions of the character ranges
+            ///
+            /// @return empty, or one position for each range
+            ///
+            const std::vector<Position>& positions() const noexcept
+            {
+                return positions_;
+            }
+        };
+
+        bool operator==(const SourceMap&, const SourceMap&) noexcept;
+        bool operator!=(const SourceMap&, const SourceMap&) noexcept;
+    }
+}
+
+#endif
@@ -10,12 +10,13 @@
 
 #include <algorithm>
 #include <iostream>
+#include <sstream>
 
 #include "refract/Element.h"
 #include "refract/FilterVisitor.h"
 #include "refract/Query.h"
 #include "refract/Iterate.h"
-#include "refract/TypeQueryVisitor.h"
+#include "refract/ElementUtils.h"
 
 #include "refract/VisitorUtils.h"
 #include "SourceMapUtils.h"
@@ -35,30 +36,50 @@ namespace
 
     std::ostream& operator<<(std::ostream& out, const dsd::Number& obj)
     {
-        out << obj.get();
-        return out;
+        return drafter::utils::so::operator<<(out, obj.native());
     }
 
-    void PrintAnnotation(const std::string& prefix,
+    // Line ends of the source, indexed at most once per report
+    class LazyLinesEndIndex
+    {
+        const std::string& source_;
+        NewLinesIndex index_;
+        bool built_ = false;
+
+    public:
+        explicit LazyLinesEndIndex(const std::string& source) : source_(source) {}
+
+        const NewLinesIndex& get()
+        {
+            if (!built_) {
+                index_ = GetLinesEndIndex(source_);
+                built_ = true;
+            }
+            return index_;
+        }
+    };
+
+    void PrintPosition(std::ostream& out, const AnnotationPosition& position)
+    {
+        out << "; line " << position.fromLine << ", column " << position.fromColumn;
+        out << " - line " << position.toLine << ", column " << position.toColumn;
+    }
+
+    void PrintAnnotation(std::ostream& out,
+        const char* prefix,
         const snowcrash::SourceAnnotation& annotation,
-        const std::string& source,
+        LazyLinesEndIndex& linesEndIndex,
         const bool useLineNumbers)
     {
 
-        std::cerr << prefix;
+        out << prefix;
 
         if (annotation.code != sc::SourceAnnotation::OK) {
-            std::cerr << " (" << annotation.code << ") ";
+            out << " (" << annotation.code << ") ";
         }
 
         if (!annotation.message.empty()) {
-            std::cerr << " " << annotation.message;
-        }
-
-        NewLinesIndex linesEndIndex;
-
-        if (useLineNumbers) {
-            linesEndIndex = GetLinesEndIndex(source);
+            out << " " << annotation.message;
         }
 
         if (!annotation.location.empty()) {
@@ -68,72 +89,44 @@ namespace
                  ++it) {
 
                 if (useLineNumbers) {
-
-                    auto annotationPosition = GetLineFromMap(linesEndIndex, *it);
-
-                    std::cerr << "; line " << annotationPosition.fromLine << ", column "
-                              << annotationPosition.fromColumn;
-                    std::cerr << " - line " << annotationPosition.toLine << ", column " << annotationPosition.toColumn;
+                    PrintPosition(out, GetLineFromMap(linesEndIndex.get(), *it));
                 } else {
 
-                    std::cerr << ((it == annotation.location.begin()) ? " :" : ";");
-                    std::cerr << it->location << ":" << it->length;
+                    out << ((it == annotation.location.begin()) ? " :" : ";");
+                    out << it->location << ":" << it->length;
                 }
             }
         }
 
-        std::cerr << std::endl;
+        out << '\n';
     }
 
-    struct AnnotationToString {
+    struct AnnotationPrinter {
 
-        std::vector<size_t> linesEndIndex;
+        std::ostream& output;
+        LazyLinesEndIndex& linesEndIndex;
         const bool useLineNumbers;
 
-        AnnotationToString(const std::string& source, const bool useLineNumbers) : useLineNumbers(useLineNumbers)
+        void location(const dsd::SourceMap::Range& range)
         {
             if (useLineNumbers) {
-                linesEndIndex = GetLinesEndIndex(source);
-            }
-        }
-
-        const std::string location(const IElement* sourceMap)
-        {
-            std::stringstream output;
-            auto map = TypeQueryVisitor::as<const ArrayElement>(sourceMap);
-            if (map && map->get().size() == 2) {
-
-                auto loc = TypeQueryVisitor::as<const NumberElement>(map->get().begin()[0].get());
-                auto len = TypeQueryVisitor::as<const NumberElement>(map->get().begin()[1].get());
-                if (loc && len) {
-
-                    if (useLineNumbers) {
-
-                        mdp::Range pos(static_cast<std::int64_t>(loc->get()), static_cast<std::int64_t>(len->get()));
-                        const auto annotationPosition = GetLineFromMap(linesEndIndex, pos);
-
-                        output << "; line " << annotationPosition.fromLine << ", column "
-                               << annotationPosition.fromColumn;
-                        output << " - line " << annotationPosition.toLine << ", column " << annotationPosition.toColumn;
-                    } else {
-                        output << loc->get() << ":" << len->get();
-                    }
-                }
+                mdp::Range pos(range.location, range.length);
+                PrintPosition(output, GetLineFromMap(linesEndIndex.get(), pos));
+            } else {
+                output << range.location << ":" << range.length;
             }
-            return output.str();
         }
 
-        const std::string operator()(const IElement* annotation)
+        void operator()(const IElement* annotation)
         {
-            std::stringstream output;
-
             if (!annotation || annotation->element() != "annotation") {
-                return output.str();
+                output << '\n';
+                return;
             }
 
             if (auto classes = FindCollectionMemberValue<ArrayElement>(annotation->meta(), "classes")) {
                 if (classes->get().size() == 1) {
-                    if (auto type = TypeQueryVisitor::as<const StringElement>(classes->get().begin()[0].get())) {
+                    if (auto type = get<const StringElement>(classes->get().begin()[0].get())) {
                         output << type->get() << ": ";
                     }
                 }
@@ -144,29 +137,36 @@ namespace
                 output << "(" << code->get() << ")  ";
             }
 
-            if (const StringElement* message = TypeQueryVisitor::as<StringElement>(annotation)) {
+            if (const StringElement* message = get<StringElement>(annotation)) {
                 output << message->get();
             }
 
             if (const ArrayElement* sourceMap
                 = FindCollectionMemberValue<ArrayElement>(annotation->attributes(), "sourceMap")) {
                 if (sourceMap->get().size() == 1) {
-                    sourceMap = TypeQueryVisitor::as<const ArrayElement>(sourceMap->get().begin()[0].get());
-                    if (sourceMap) {
-                        for (const auto& array : sourceMap->get()) {
+                    if (auto map = get<const SourceMapElement>(sourceMap->get().begin()[0].get())) {
+                        const auto& ranges = map->get().ranges();
+                        for (auto it = ranges.begin(); it != ranges.end(); ++it) {
                             if (!useLineNumbers) {
-                                const char* prefix = array == (*sourceMap->get().begin()) ? " :" : ";";
-                                output << prefix;
+                                output << ((it == ranges.begin()) ? " :" : ";");
                             }
-                            output << location(array.get());
+                            location(*it);
                         }
                     }
                 }
             };
 
-            return output.str();
+            output << '\n';
         }
     };
+
+    // write the whole report at once
+    void Flush(std::ostream& out, const std::ostringstream& report)
+    {
+        const std::string buffer = report.str();
+        out.write(buffer.data(), buffer.size());
+        out.flush();
+    }
 } // namespace
 
 /**
@@ -177,34 +177,52 @@ namespace
  */
 void PrintReport(const snowcrash::Report& report, const std::string& source, const bool isUseLineNumbers)
 {
+    std::ostringstream output;
+    LazyLinesEndIndex linesEndIndex(source);
 
-    std::cerr << std::endl;
+    output << '\n';
 
     if (report.error.code == sc::Error::OK) {
-        std::cerr << "OK.\n";
+        output << "OK.\n";
     } else {
-        PrintAnnotation("error:", report.error, source, isUseLineNumbers);
+        PrintAnnotation(output, "error:", report.error, linesEndIndex, isUseLineNumbers);
     }
 
     for (snowcrash::Warnings::const_iterator it = report.warnings.begin(); it != report.warnings.end(); ++it) {
-        PrintAnnotation("warning:", *it, source, isUseLineNumbers);
+        PrintAnnotation(output, "warning:", *it, linesEndIndex, isUseLineNumbers);
     }
+
+    Flush(std::cerr, output);
 }
 
 void PrintReport(const drafter_result* result, const std::string& source, const bool useLineNumbers, const int error)
 {
-    std::cerr << std::endl;
+    PrintReport(std::cerr, result, source, useLineNumbers, error);
+}
+
+void PrintReport(std::ostream& out,
+    const drafter_result* result,
+    const std::string& source,
+    const bool useLineNumbers,
+    const int error)
+{
+    std::ostringstream output;
+    LazyLinesEndIndex linesEndIndex(source);
+
+    output << '\n';
 
     FilterVisitor filter(query::Element("annotation"));
     Iterate<Children> iterate(filter);
-    iterate(*result);
+    if (result)
+        iterate(*result);
 
     if (error == sc::Error::OK) {
-        std::cerr << "OK.\n";
+        output << "OK.\n";
     }
 
-    std::transform(filter.elements().begin(),
+    std::for_each(filter.elements().begin(),
         filter.elements().end(),
-        std::ostream_iterator<std::string>(std::cerr, "\n"),
-        AnnotationToString(source, useLineNumbers));
+        AnnotationPrinter{ output, linesEndIndex, useLineNumbers });
+
+    Flush(out, output);
 }
@@ -12,6 +12,8 @@
 #include "drafter.h"
 #include "SourceAnnotation.h"
 
+#include <iosfwd>
+
 /**
  *  \brief Print parser report to stderr.
  *
@@ -31,4 +33,19 @@ void PrintReport(const snowcrash::Report& report, const std::string& source, con
  */
 void PrintReport(const drafter_result*, const std::string& source, const bool useLineNumbers, const int error);
 
+/**
+ *  \brief Print parser report to given stream.
+ *
+ *  \param out Stream to print the report to
+ *  \param report A parser report to print, NULL if there are no annotations
+ *  \param source Source data
+ *  \param useLineNumbers True if the annotations needs to be printed by line and column number
+ *  \param error - code form parsing
+ */
+void PrintReport(std::ostream& out,
+    const drafter_result*,
+    const std::string& source,
+    const bool useLineNumbers,
+    const int error);
+
 #endif // #ifndef DRAFTER_REPORTING_H
@@ -0,0 +1,296 @@
+//
+//  utils/so/Escape.cc
+//  librefract
+//
+//  Copyright (c) 2020 Apiary Inc. All rights reserved.
+//
+
+#include "Escape.h"
+
+#include "OutputBuffer.h"
+#include "../Utf8.h"
+
+#include <cstdint>
+#include <cstdio>
+
+#if defined(__AVX2__)
+#define DRAFTER_ESCAPE_AVX2 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DRAFTER_ESCAPE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+using namespace drafter;
+using namespace utils;
+using namespace so;
+
+namespace
+{
+    inline bool is_json_special(unsigned char c) noexcept
+    {
+        return c < 0x20 || c == '"' || c == '\\';
+    }
+
+    inline bool is_yaml_special(unsigned char c) noexcept
+    {
+        return c < 0x20 || c >= 0x7F || c == '"' || c == '\\';
+    }
+
+#if defined(DRAFTER_ESCAPE_AVX2) || defined(DRAFTER_ESCAPE_SSE2)
+    inline unsigned lowest_bit(std::uint32_t mask) noexcept
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return index;
+#else
+        return __builtin_ctz(mask);
+#endif
+    }
+#endif
+
+#if defined(DRAFTER_ESCAPE_AVX2)
+    constexpr std::size_t block_size = 32;
+
+    inline std::uint32_t json_special_mask(const char* p) noexcept
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+
+        // unsigned v <= 0x1F
+        const __m256i control = _mm256_cmpeq_epi8(_mm256_max_epu8(v, _mm256_set1_epi8(0x1F)), _mm256_set1_epi8(0x1F));
+        const __m256i quote = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('"'));
+        const __m256i backslash = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\'));
+
+        return _mm256_movemask_epi8(_mm256_or_si256(control, _mm256_or_si256(quote, backslash)));
+    }
+
+    inline std::uint32_t yaml_special_mask(const char* p) noexcept
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+
+        // signed v < 0x20 covers both control characters and bytes >= 0x80
+        const __m256i outside = _mm256_cmpgt_epi8(_mm256_set1_epi8(0x20), v);
+        const __m256i del = _mm256_cmpeq_epi8(v, _mm256_set1_epi8(0x7F));
+        const __m256i quote = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('"'));
+        const __m256i backslash = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\'));
+
+        return _mm256_movemask_epi8(
+            _mm256_or_si256(_mm256_or_si256(outside, del), _mm256_or_si256(quote, backslash)));
+    }
+#elif defined(DRAFTER_ESCAPE_SSE2)
+    constexpr std::size_t block_size = 16;
+
+    inline std::uint32_t json_special_mask(const char* p) noexcept
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+
+        // unsigned v <= 0x1F
+        const __m128i control = _mm_cmpeq_epi8(_mm_max_epu8(v, _mm_set1_epi8(0x1F)), _mm_set1_epi8(0x1F));
+        const __m128i quote = _mm_cmpeq_epi8(v, _mm_set1_epi8('"'));
+        const __m128i backslash = _mm_cmpeq_epi8(v, _mm_set1_epi8('\\'));
+
+        return _mm_movemask_epi8(_mm_or_si128(control, _mm_or_si128(quote, backslash)));
+    }
+
+    inline std::uint32_t yaml_special_mask(const char* p) noexcept
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+
+        // signed v < 0x20 covers both control characters and bytes >= 0x80
+        const __m128i outside = _mm_cmplt_epi8(v, _mm_set1_epi8(0x20));
+        const __m128i del = _mm_cmpeq_epi8(v, _mm_set1_epi8(0x7F));
+        const __m128i quote = _mm_cmpeq_epi8(v, _mm_set1_epi8('"'));
+        const __m128i backslash = _mm_cmpeq_epi8(v, _mm_set1_epi8('\\'));
+
+        return _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(outside, del), _mm_or_si128(quote, backslash)));
+    }
+#endif
+
+    void append_escape(output_buffer& out, char c)
+    {
+        const char sequence[2] = { '\\', c };
+        out.append(sequence, 2);
+    }
+
+    void append_json_special(output_buffer& out, unsigned char c)
+    {
+        switch (c) {
+            case '"':
+                append_escape(out, '"');
+                break;
+            case '\\':
+                append_escape(out, '\\');
+                break;
+            case '\b':
+                append_escape(out, 'b');
+                break;
+            case '\f':
+                append_escape(out, 'f');
+                break;
+            case '\n':
+                append_escape(out, 'n');
+                break;
+            case '\r':
+                append_escape(out, 'r');
+                break;
+            case '\t':
+                append_escape(out, 't');
+                break;
+            default: { // escaped control sequences
+                char u_sym_buf[7];
+                std::snprintf(u_sym_buf, 7, "\\u%04x", c);
+                out.append(u_sym_buf, 6);
+            }
+        }
+    }
+
+    bool is_yaml_printable(utf8::codepoint c)
+    {
+        return (c == 0x9)                                  //
+            || (c == 0xA)                                  //
+            || (c == 0xD)                                  //
+            || (0x20 <= c && c <= 0x7E)                    //
+            || (c == 0x85)                                 //
+            || (0xA0 <= c && c <= 0xD7FF)                  //
+            || (0xE000 <= c && c <= 0xFFFD && c != 0xFEFF) //
+            || (0x10000 <= c && c <= 0x10FFFF);
+    }
+
+    void append_yaml_escaped(output_buffer& out, utf8::codepoint c)
+    {
+        if (c < 0x100) { // 8-bit
+            char u_sym_buf[5];
+            std::snprintf(u_sym_buf, 5, "\\x%02X", c);
+            out.append(u_sym_buf, 4);
+        } else if (c < 0x10000) { // 16-bit
+            char u_sym_buf[7];
+            std::snprintf(u_sym_buf, 7, "\\u%04X", c);
+            out.append(u_sym_buf, 6);
+        } else { // 32-bit
+            char u_sym_buf[11];
+            std::snprintf(u_sym_buf, 11, "\\U%08X", c);
+            out.append(u_sym_buf, 10);
+        }
+    }
+
+    void append_yaml_codepoint(output_buffer& out, utf8::codepoint c)
+    {
+        switch (c) {
+            case 0x0000: // null
+                append_escape(out, '0');
+                break;
+            case 0x0007: // bell
+                append_escape(out, 'a');
+                break;
+            case 0x0008: // backspace
+                append_escape(out, 'b');
+                break;
+            case 0x0009: // horizontal tab
+                append_escape(out, 't');
+                break;
+            case 0x000A: // line feed
+                append_escape(out, 'n');
+                break;
+            case 0x000B: // vertical tab
+                append_escape(out, 'v');
+                break;
+            case 0x000C: // form feed
+                append_escape(out, 'f');
+                break;
+            case 0x000D: // carriage return
+                append_escape(out, 'r');
+                break;
+            case 0x001B: // escape
+                append_escape(out, 'e');
+                break;
+            case 0x0022: // double quote
+                append_escape(out, '"');
+                break;
+            case 0x005C: // back slash
+                append_escape(out, '\\');
+                break;
+            case 0x0085: // utf next line
+                append_escape(out, 'N');
+                break;
+            case 0x00A0: // utf non-breaking space
+                append_escape(out, '_');
+                break;
+            case 0x2028: // utf line separator
+                append_escape(out, 'L');
+                break;
+            case 0x2029: // utf paragraph separator
+                append_escape(out, 'P');
+                break;
+            default: {
+                if (is_yaml_printable(c)) {
+                    char encoded[4];
+                    const char* end = utf8::encode(c, encoded);
+                    out.append(encoded, end - encoded);
+                } else {
+                    append_yaml_escaped(out, c);
+                }
+            }
+        }
+    }
+} // namespace
+
+const char* so::find_json_special(const char* first, const char* last) noexcept
+{
+#if defined(DRAFTER_ESCAPE_AVX2) || defined(DRAFTER_ESCAPE_SSE2)
+    for (; static_cast<std::size_t>(last - first) >= block_size; first += block_size)
+        if (const std::uint32_t mask = json_special_mask(first))
+            return first + lowest_bit(mask);
+#endif
+    for (; first != last; ++first)
+        if (is_json_special(static_cast<unsigned char>(*first)))
+            return first;
+    return last;
+}
+
+const char* so::find_yaml_special(const char* first, const char* last) noexcept
+{
+#if defined(DRAFTER_ESCAPE_AVX2) || defined(DRAFTER_ESCAPE_SSE2)
+    for (; static_cast<std::size_t>(last - first) >= block_size; first += block_size)
+        if (const std::uint32_t mask = yaml_special_mask(first))
+            return first + lowest_bit(mask);
+#endif
+    for (; first != last; ++first)
+        if (is_yaml_special(static_cast<unsigned char>(*first)))
+            return first;
+    return last;
+}
+
+void so::escape_json(output_buffer& out, const char* first, const char* last)
+{
+    while (first != last) {
+        const char* special = find_json_special(first, last);
+        out.append(first, special - first);
+
+        if (special == last)
+            break;
+
+        append_json_special(out, static_cast<unsigned char>(*special));
+        first = special + 1;
+    }
+}
+
+void so::escape_yaml(output_buffer& out, const char* first, const char* last)
+{
+    while (first != last) {
+        const char* special = find_yaml_special(first, last);
+        out.append(first, special - first);
+
+        if (special == last)
+            break;
+
+        // non-ASCII sequences are decoded and validated one codepoint at a time
+        const auto decoded = utf8::decode_one(special, last);
+        append_yaml_codepoint(out, decoded.first);
+        first = decoded.second;
+    }
+}
@@ -0,0 +1,61 @@
+//
+//  utils/so/Escape.h
+//  librefract
+//
+//  Copyright (c) 2020 Apiary Inc. All rights reserved.
+//
+
+#ifndef DRAFTER_UTILS_SO_ESCAPE_H
+#define DRAFTER_UTILS_SO_ESCAPE_H
+
+#include <string>
+
+namespace drafter
+{
+    namespace utils
+    {
+        namespace so
+        {
+            class output_buffer;
+
+            ///
+            /// Find first byte of [first, last) which cannot be copied into a
+            /// JSON string literal verbatim
+            ///
+            /// Scans 16 or 32 bytes at a time where SSE2 or AVX2 is available.
+            ///
+            /// @returns    pointer to the byte; last if there is none
+            ///
+            const char* find_json_special(const char* first, const char* last) noexcept;
+
+            ///
+            /// Find first byte of [first, last) which cannot be copied into a
+            /// double-quoted YAML scalar verbatim; that is any byte outside of
+            /// printable ASCII and any quote or backslash
+            ///
+            /// Scans 16 or 32 bytes at a time where SSE2 or AVX2 is available.
+            ///
+            /// @returns    pointer to the byte; last if there is none
+            ///
+            const char* find_yaml_special(const char* first, const char* last) noexcept;
+
+            /// Escape contents of a JSON string literal, excluding the quotes
+            void escape_json(output_buffer& out, const char* first, const char* last);
+
+            /// Escape contents of a double-quoted YAML scalar, excluding the quotes
+            void escape_yaml(output_buffer& out, const char* first, const char* last);
+
+            inline void escape_json(output_buffer& out, const std::string& str)
+            {
+                escape_json(out, str.data(), str.data() + str.size());
+            }
+
+            inline void escape_yaml(output_buffer& out, const std::string& str)
+            {
+                escape_yaml(out, str.data(), str.data() + str.size());
+            }
+        }
+    }
+}
+
+#endif
@@ -7,15 +7,10 @@
 //
 
 #include "JsonIo.h"
+#include "Escape.h"
 
-#include <algorithm>
-#include <cstdio>
-#include <cmath>
-#include <iostream>
-#include <iterator>
+#include <cassert>
 #include <string>
-#include <tuple>
-#include <array>
 
 using namespace drafter;
 using namespace utils;
@@ -23,191 +18,210 @@ using namespace so;
 
 namespace
 {
-    template <typename It>
-    It json_utf_char(It out, unsigned int c)
-    {
-        char u_sym_buf[7];
-        std::snprintf(u_sym_buf, 7, "\\u%04x", c);
-        return std::copy( //
-            u_sym_buf,
-            u_sym_buf + 6,
-            out);
-    }
+    template <typename Writer>
+    struct number_printer final {
+        Writer& out;
 
-    template <typename ItI, typename ItO>
-    ItO escape_json_string(ItI b, ItI e, ItO out)
-    {
-        for (; b != e; ++b) {
-
-            char byte = *b;
-            switch (byte) {
-                case '\"':
-                    *out = '\\';
-                    ++out;
-                    *out = '"';
-                    ++out;
-                    break;
-                case '\\':
-                    *out = '\\';
-                    ++out;
-                    *out = '\\';
-                    ++out;
-                    break;
-                case '\b':
-                    *out = '\\';
-                    ++out;
-                    *out = 'b';
-                    ++out;
-                    break;
-                case '\f':
-                    *out = '\\';
-                    ++out;
-                    *out = 'f';
-                    ++out;
-                    break;
-                case '\n':
-                    *out = '\\';
-                    ++out;
-                    *out = 'n';
-                    ++out;
-                    break;
-                case '\r':
-                    *out = '\\';
-                    ++out;
-                    *out = 'r';
-                    ++out;
-                    break;
-                case '\t':
-                    *out = '\\';
-                    ++out;
-                    *out = 't';
-                    ++out;
-                    break;
-                default: {
-                    // unsigned int representation
-                    std::uint8_t c = static_cast<std::uint8_t>(byte);
-                    if (c > 0x1f) { // non-control
-                        *out = byte;
-                        ++out;
-                    } else { // escaped control sequences
-                        out = json_utf_char(out, c);
-                    }
-                }
-            }
+        template <typename T>
+        void operator()(const T& value) const
+        {
+            out.number(value);
         }
-        return out;
-    }
+    };
 
-    std::ostream& break_indent(std::ostream& out, int indent)
+    void break_indent(output_buffer& out, std::size_t indent)
     {
-        out << '\n';
-        for (; indent > 0; --indent)
-            out << "  ";
-        return out;
+        out.append('\n');
+        out.fill(' ', 2 * indent);
     }
 
-    template <bool Packed = true>
     struct json_printer final {
-        std::ostream& out;
-        const int indent;
+        json_writer& out;
 
         void operator()(const Null& value) const
         {
-            out << "null";
+            out.null();
         }
 
         void operator()(const True& value) const
         {
-            out << "true";
+            out.boolean(true);
         }
 
         void operator()(const False& value) const
         {
-            out << "false";
+            out.boolean(false);
         }
 
         void operator()(const String& value) const
         {
-            out << '"';
-            escape_json_string( //
-                value.data.begin(),
-                value.data.end(),
-                std::ostream_iterator<char>(out));
-            out << '"';
+            out.string(value.data);
         }
 
         void operator()(const Number& value) const
         {
-            out << value.data;
+            out.number(value);
+        }
+
+        void operator()(const Object& value) const
+        {
+            out.begin_object();
+            for (const auto& m : value.data) {
+                out.key(m.first);
+                mpark::visit(*this, m.second);
+            }
+            out.end_object();
         }
 
-        void operator()(const Object& value) const;
-        void operator()(const Array& value) const;
+        void operator()(const Array& value) const
+        {
+            out.begin_array();
+            for (const auto& m : value.data) {
+                mpark::visit(*this, m);
+            }
+            out.end_array();
+        }
     };
+} // namespace
 
-    template <bool Packed>
-    void visit(const Value& obj, std::ostream& out, int indent = 0)
-    {
-        mpark::visit(json_printer<Packed>{ out, indent }, obj);
+json_writer::json_writer(std::ostream& out) : out_(out), packed_(false) {}
+
+json_writer::json_writer(std::ostream& out, packed) : out_(out), packed_(true) {}
+
+void json_writer::begin_value()
+{
+    if (keyed_) {
+        keyed_ = false;
+        return;
     }
 
-    template <bool Packed>
-    void json_printer<Packed>::operator()(const Object& value) const
-    {
-        out << '{';
-        int commas = value.data.size() - 1;
-        for (const auto& m : value.data) {
-            if (!Packed)
-                break_indent(out, indent + 1);
+    if (entries_.empty())
+        return;
 
-            out << '"';
-            escape_json_string(m.first.begin(), m.first.end(), std::ostream_iterator<char>(out));
-            out << "\":";
+    // array item
+    if (entries_.back()++ > 0)
+        out_.append(',');
 
-            if (!Packed)
-                out << ' ';
+    if (!packed_)
+        break_indent(out_, entries_.size());
+}
 
-            visit<Packed>(m.second, out, indent + 1);
+void json_writer::begin_object()
+{
+    begin_value();
+    out_.append('{');
+    entries_.push_back(0);
+}
 
-            if (commas > 0) {
-                out << ',';
-                --commas;
-            }
-        }
-        if (!(Packed || value.data.empty()))
-            break_indent(out, indent);
-        out << '}';
-    }
+void json_writer::end_object()
+{
+    assert(!entries_.empty());
+    const std::size_t entries = entries_.back();
+    entries_.pop_back();
 
-    template <bool Packed>
-    void json_printer<Packed>::operator()(const Array& value) const
-    {
-        out << '[';
-        int commas = value.data.size() - 1;
-        for (const auto& m : value.data) {
-            if (!Packed)
-                break_indent(out, indent + 1);
-            visit<Packed>(m, out, indent + 1);
-
-            if (commas > 0) {
-                out << ',';
-                --commas;
-            }
-        }
-        if (!(Packed || value.data.empty()))
-            break_indent(out, indent);
-        out << ']';
-    }
-} // namespace
+    if (!packed_ && entries > 0)
+        break_indent(out_, entries_.size());
+    out_.append('}');
+}
+
+void json_writer::begin_array()
+{
+    begin_value();
+    out_.append('[');
+    entries_.push_back(0);
+}
+
+void json_writer::end_array()
+{
+    assert(!entries_.empty());
+    const std::size_t entries = entries_.back();
+    entries_.pop_back();
+
+    if (!packed_ && entries > 0)
+        break_indent(out_, entries_.size());
+    out_.append(']');
+}
+
+void json_writer::key(const std::string& key)
+{
+    assert(!entries_.empty());
+    assert(!keyed_);
+
+    if (entries_.back()++ > 0)
+        out_.append(',');
+
+    if (!packed_)
+        break_indent(out_, entries_.size());
+
+    out_.append('"');
+    escape_json(out_, key);
+
+    if (packed_)
+        out_.append("\":");
+    else
+        out_.append("\": ");
+
+    keyed_ = true;
+}
+
+void json_writer::null()
+{
+    begin_value();
+    out_.append("null");
+}
+
+void json_writer::boolean(bool value)
+{
+    begin_value();
+    if (value)
+        out_.append("true");
+    else
+        out_.append("false");
+}
+
+void json_writer::string(const std::string& value)
+{
+    begin_value();
+    out_.append('"');
+    escape_json(out_, value);
+    out_.append('"');
+}
+
+void json_writer::number(const std::string& value)
+{
+    begin_value();
+    out_.append(value);
+}
+
+void json_writer::number(std::int64_t value)
+{
+    begin_value();
+    char buffer[number_chars];
+    out_.append(buffer, render_number(buffer, value));
+}
+
+void json_writer::number(double value)
+{
+    begin_value();
+    char buffer[number_chars];
+    out_.append(buffer, render_number(buffer, value));
+}
+
+void json_writer::number(const Number& value)
+{
+    mpark::visit(number_printer<json_writer>{ *this }, value.data);
+}
 
 std::ostream& so::serialize_json(std::ostream& out, const Value& obj)
 {
-    visit<false>(obj, out);
+    json_writer writer(out);
+    mpark::visit(json_printer{ writer }, obj);
     return out;
 }
 
 std::ostream& so::serialize_json(std::ostream& out, const Value& obj, packed)
 {
-    visit<true>(obj, out);
+    json_writer writer(out, packed{});
+    mpark::visit(json_printer{ writer }, obj);
     return out;
 }
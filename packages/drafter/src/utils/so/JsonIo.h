@@ -10,6 +10,10 @@
 #define DRAFTER_UTILS_SO_JSONIO_H
 
 #include "Value.h"
+#include "OutputBuffer.h"
+
+#include <iosfwd>
+#include <vector>
 
 namespace drafter
 {
@@ -22,6 +26,45 @@ namespace drafter
 
             std::ostream& serialize_json(std::ostream& out, const Value& obj);
             std::ostream& serialize_json(std::ostream& out, const Value& obj, packed);
+
+            ///
+            /// Streaming JSON writer
+            ///
+            /// Writes JSON tokens into the output stream, formatted exactly
+            /// the way serialize_json formats an equivalent Value. Object
+            /// members are written as key() followed by their value. Output
+            /// is buffered and flushed once the writer is destroyed.
+            ///
+            class json_writer
+            {
+                output_buffer out_;
+                const bool packed_;
+                std::vector<std::size_t> entries_; // entries written per open container
+                bool keyed_ = false;               // next value belongs to the key just written
+
+            public:
+                explicit json_writer(std::ostream& out);
+                json_writer(std::ostream& out, packed);
+
+                void begin_object();
+                void end_object();
+
+                void begin_array();
+                void end_array();
+
+                void key(const std::string& key);
+
+                void null();
+                void boolean(bool value);
+                void string(const std::string& value);
+                void number(const std::string& value);
+                void number(std::int64_t value);
+                void number(double value);
+                void number(const Number& value);
+
+            private:
+                void begin_value();
+            };
         }
     }
 }
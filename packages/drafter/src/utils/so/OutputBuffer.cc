@@ -0,0 +1,54 @@
+//
+//  utils/so/OutputBuffer.cc
+//  librefract
+//
+//  Copyright (c) 2020 Apiary Inc. All rights reserved.
+//
+
+#include "OutputBuffer.h"
+
+#include <algorithm>
+#include <ostream>
+
+using namespace drafter;
+using namespace utils;
+using namespace so;
+
+constexpr std::size_t output_buffer::capacity;
+
+output_buffer::output_buffer(std::ostream& out) : out_(out) {}
+
+output_buffer::~output_buffer()
+{
+    flush();
+}
+
+void output_buffer::fill(char c, std::size_t count)
+{
+    while (count > 0) {
+        if (data_.size() == capacity)
+            flush();
+
+        const std::size_t n = std::min(count, capacity - data_.size());
+        data_.append(n, c);
+        count -= n;
+    }
+}
+
+void output_buffer::flush()
+{
+    if (!data_.empty()) {
+        out_.write(data_.data(), data_.size());
+        data_.clear();
+    }
+}
+
+void output_buffer::spill(const char* data, std::size_t size)
+{
+    flush();
+
+    if (size > capacity)
+        out_.write(data, size);
+    else
+        data_.append(data, size);
+}
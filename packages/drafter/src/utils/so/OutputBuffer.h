@@ -0,0 +1,83 @@
+//
+//  utils/so/OutputBuffer.h
+//  librefract
+//
+//  Copyright (c) 2020 Apiary Inc. All rights reserved.
+//
+
+#ifndef DRAFTER_UTILS_SO_OUTPUTBUFFER_H
+#define DRAFTER_UTILS_SO_OUTPUTBUFFER_H
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+namespace drafter
+{
+    namespace utils
+    {
+        namespace so
+        {
+            ///
+            /// Growable output buffer in front of a std::ostream
+            ///
+            /// Collects small writes in memory and hands them to the stream
+            /// in chunks of up to `capacity` bytes; writes larger than that
+            /// bypass it. Memory is allocated as data comes in, so writers of
+            /// small documents stay small. Remaining data is flushed on
+            /// destruction.
+            ///
+            class output_buffer
+            {
+                std::ostream& out_;
+                std::string data_;
+
+            public:
+                static constexpr std::size_t capacity = 64 * 1024;
+
+                explicit output_buffer(std::ostream& out);
+                ~output_buffer();
+
+                output_buffer(const output_buffer&) = delete;
+                output_buffer& operator=(const output_buffer&) = delete;
+
+                void append(const char* data, std::size_t size)
+                {
+                    if (data_.size() + size > capacity)
+                        spill(data, size);
+                    else
+                        data_.append(data, size);
+                }
+
+                void append(const std::string& data)
+                {
+                    append(data.data(), data.size());
+                }
+
+                template <std::size_t N>
+                void append(const char (&literal)[N])
+                {
+                    append(literal, N - 1);
+                }
+
+                void append(char c)
+                {
+                    if (data_.size() == capacity)
+                        flush();
+                    data_.push_back(c);
+                }
+
+                /// Append `count` copies of `c`
+                void fill(char c, std::size_t count);
+
+                /// Write buffered data to the underlying stream
+                void flush();
+
+            private:
+                void spill(const char* data, std::size_t size);
+            };
+        }
+    }
+}
+
+#endif
@@ -9,6 +9,11 @@
 #include "Value.h"
 
 #include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ostream>
 
 using namespace drafter::utils::so;
 
@@ -34,7 +39,82 @@ bool drafter::utils::so::operator==(const String& lhs, const String& rhs)
 
 bool drafter::utils::so::operator==(const Number& lhs, const Number& rhs)
 {
-    return lhs.data == rhs.data;
+    if (lhs.data.index() == rhs.data.index())
+        return lhs.data == rhs.data;
+    return to_string(lhs) == to_string(rhs);
+}
+
+std::size_t drafter::utils::so::render_number(char (&buffer)[number_chars], std::int64_t value) noexcept
+{
+    return static_cast<std::size_t>(std::snprintf(buffer, number_chars, "%" PRId64, value));
+}
+
+std::size_t drafter::utils::so::render_number(char (&buffer)[number_chars], double value) noexcept
+{
+    // JSON has no representation of infinities and NaN
+    if (!std::isfinite(value))
+        return static_cast<std::size_t>(std::snprintf(buffer, number_chars, "null"));
+
+    int written = 0;
+    for (int precision = 15; precision <= 17; ++precision) {
+        written = std::snprintf(buffer, number_chars, "%.*g", precision, value);
+        if (std::strtod(buffer, nullptr) == value)
+            break;
+    }
+    return static_cast<std::size_t>(written);
+}
+
+namespace
+{
+    void write(std::string& out, const char* text, std::size_t size)
+    {
+        out.append(text, size);
+    }
+
+    void write(std::ostream& out, const char* text, std::size_t size)
+    {
+        out.write(text, static_cast<std::streamsize>(size));
+    }
+
+    template <typename Out>
+    struct number_renderer final {
+        Out& out;
+
+        void operator()(std::int64_t value) const
+        {
+            char buffer[number_chars];
+            write(out, buffer, render_number(buffer, value));
+        }
+
+        void operator()(double value) const
+        {
+            char buffer[number_chars];
+            write(out, buffer, render_number(buffer, value));
+        }
+
+        void operator()(const std::string& value) const
+        {
+            write(out, value.data(), value.size());
+        }
+    };
+} // namespace
+
+std::string drafter::utils::so::to_string(const Number& value)
+{
+    std::string result;
+    append_number(result, value);
+    return result;
+}
+
+void drafter::utils::so::append_number(std::string& out, const Number& value)
+{
+    mpark::visit(number_renderer<std::string>{ out }, value.data);
+}
+
+std::ostream& drafter::utils::so::operator<<(std::ostream& out, const Number& value)
+{
+    mpark::visit(number_renderer<std::ostream>{ out }, value.data);
+    return out;
 }
 
 namespace
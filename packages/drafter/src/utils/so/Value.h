@@ -11,6 +11,10 @@
 
 #include <vector>
 #include <string>
+#include <cstdint>
+#include <iosfwd>
+#include <limits>
+#include <type_traits>
 #include <algorithm>
 #include <boost/container/vector.hpp>
 #include <mpark/variant.hpp>
@@ -92,8 +96,15 @@ namespace drafter
                 explicit String(std::string d) : data(d) {}
             };
 
+            ///
+            /// Number held in its native representation
+            ///
+            /// Integers and reals are rendered to text only once written;
+            /// literals are kept verbatim so they round-trip exactly.
+            ///
             struct Number {
-                std::string data = "0";
+                using data_type = mpark::variant<std::int64_t, double, std::string>;
+                data_type data = std::int64_t{ 0 };
 
                 Number() = default;
                 Number(const Number&) = default;
@@ -105,10 +116,58 @@ namespace drafter
                 explicit Number(std::string d) : data(std::move(d)) {}
 
                 template <typename N, typename = typename std::enable_if<std::is_integral<N>::value>::type>
-                explicit Number(N v) noexcept : data(std::to_string(v))
+                explicit Number(N v) noexcept : data(native(v, std::is_unsigned<N>{}))
                 {
                 }
+
+                explicit Number(double v) noexcept : data(v) {}
+
+            private:
+                template <typename N>
+                static data_type native(N v, std::false_type)
+                {
+                    return static_cast<std::int64_t>(v);
+                }
+
+                template <typename N>
+                static data_type native(N v, std::true_type)
+                {
+                    // unsigned values beyond the int64 range fall back to their literal
+                    if (static_cast<std::uint64_t>(v) > static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()))
+                        return std::to_string(v);
+                    return static_cast<std::int64_t>(v);
+                }
             };
+
+            /// Upper bound of characters needed to render a native number
+            constexpr std::size_t number_chars = 32;
+
+            ///
+            /// Render a native number into a buffer
+            ///
+            /// Reals are rendered with the least precision that still
+            /// reads back to the same value; infinities and NaN, having no
+            /// JSON representation, are rendered as `null`.
+            ///
+            /// @returns the count of characters written
+            ///
+            std::size_t render_number(char (&buffer)[number_chars], std::int64_t value) noexcept;
+            std::size_t render_number(char (&buffer)[number_chars], double value) noexcept;
+
+            ///
+            /// Render a Number to text
+            ///
+            std::string to_string(const Number& value);
+
+            ///
+            /// Append a Number as text, as rendered by to_string
+            ///
+            void append_number(std::string& out, const Number& value);
+
+            ///
+            /// Write a Number as text, as rendered by to_string
+            ///
+            std::ostream& operator<<(std::ostream& out, const Number& value);
         } // namespace so
 
         namespace so
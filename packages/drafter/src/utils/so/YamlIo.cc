@@ -7,15 +7,10 @@
 //
 
 #include "YamlIo.h"
+#include "Escape.h"
 
-#include <algorithm>
 #include <cassert>
-#include <exception>
-#include <iostream>
-#include <iterator>
 #include <mpark/variant.hpp>
-#include "../Utf8.h"
-#include "../Utils.h"
 
 using namespace drafter;
 using namespace utils;
@@ -23,7 +18,16 @@ using namespace so;
 
 namespace
 {
-    using namespace utf8;
+    template <typename Writer>
+    struct number_printer final {
+        Writer& out;
+
+        template <typename T>
+        void operator()(const T& value) const
+        {
+            out.number(value);
+        }
+    };
 
     bool is_alphanum_dash(const std::string& str)
     {
@@ -33,256 +37,196 @@ namespace
         return true;
     }
 
-    bool is_yaml_printable(const codepoint& c)
+    void quote_yaml_string(output_buffer& out, const std::string& str)
     {
-        return (c == 0x9)                                  //
-            || (c == 0xA)                                  //
-            || (c == 0xD)                                  //
-            || (0x20 <= c && c <= 0x7E)                    //
-            || (c == 0x85)                                 //
-            || (0xA0 <= c && c <= 0xD7FF)                  //
-            || (0xE000 <= c && c <= 0xFFFD && c != 0xFEFF) //
-            || (0x10000 <= c && c <= 0x10FFFF);
+        out.append('"');
+        escape_yaml(out, str);
+        out.append('"');
     }
 
-    template <typename It>
-    It serialize_escaped(codepoint c, It out)
+    void do_indent(output_buffer& out, std::size_t indent)
     {
-        if (c < 0x100) { // 8-bit
-            char u_sym_buf[5];
-            std::snprintf(u_sym_buf, 5, "\\x%02X", c);
-            return std::copy(u_sym_buf, u_sym_buf + 4, out);
-        } else if (c < 0x10000) { // 16-bit
-            char u_sym_buf[7];
-            std::snprintf(u_sym_buf, 7, "\\u%04X", c);
-            return std::copy(u_sym_buf, u_sym_buf + 6, out);
-        } else { // 32-bit
-            char u_sym_buf[11];
-            std::snprintf(u_sym_buf, 11, "\\U%08X", c);
-            return std::copy(u_sym_buf, u_sym_buf + 10, out);
-        }
-    }
-
-    template <typename It>
-    It escape_sequence(char c, It out)
-    {
-        constexpr char ESCAPE = '\\';
-
-        *out = ESCAPE;
-        ++out;
-        *out = c;
-        ++out;
-        return out;
-    }
-
-    template <typename ItI, typename ItO>
-    ItO escape_yaml_string(ItI b, ItI e, ItO out)
-    {
-        using utf8_iterator = input_iterator<ItI>;
-
-        utf8_iterator p{ b, e };
-        const utf8_iterator end{ e, e };
-
-        for (; p != end; ++p) {
-            codepoint c = *p;
-            switch (c) {
-                case 0x0000: // null
-                    out = escape_sequence('0', out);
-                    break;
-                case 0x0007: // bell
-                    out = escape_sequence('a', out);
-                    break;
-                case 0x0008: // backspace
-                    out = escape_sequence('b', out);
-                    break;
-                case 0x0009: // horizontal tab
-                    out = escape_sequence('t', out);
-                    break;
-                case 0x000A: // line feed
-                    out = escape_sequence('n', out);
-                    break;
-                case 0x000B: // vertical tab
-                    out = escape_sequence('v', out);
-                    break;
-                case 0x000C: // form feed
-                    out = escape_sequence('f', out);
-                    break;
-                case 0x000D: // carriage return
-                    out = escape_sequence('r', out);
-                    break;
-                case 0x001B: // escape
-                    out = escape_sequence('e', out);
-                    break;
-                // case 0x0020: // space
-                //    out = escape_sequence('', out);
-                //    break;
-                case 0x0022: // double quote
-                    out = escape_sequence('"', out);
-                    break;
-                // case 0x002F: // slash
-                //    out = escape_sequence('/', out);
-                //    break;
-                case 0x005C: // back slash
-                    out = escape_sequence('\\', out);
-                    break;
-                case 0x0085: // utf next line
-                    out = escape_sequence('N', out);
-                    break;
-                case 0x00A0: // utf non-breaking space
-                    out = escape_sequence('_', out);
-                    break;
-                case 0x2028: // utf line separator
-                    out = escape_sequence('L', out);
-                    break;
-                case 0x2029: // utf paragraph separator
-                    out = escape_sequence('P', out);
-                    break;
-                default: {
-                    if (is_yaml_printable(c)) {
-                        out = encode(c, out);
-                    } else {
-                        out = serialize_escaped(c, out);
-                    }
-                }
-            }
-        }
-        return out;
-    }
-
-    std::ostream& serialize_yaml(std::ostream& out, const std::string& obj)
-    {
-        out << '"';
-        escape_yaml_string( //
-            obj.begin(),
-            obj.end(),
-            std::ostream_iterator<char>(out));
-        out << '"';
-        return out;
-    }
-
-    std::ostream& do_indent(std::ostream& out, int indent)
-    {
-        for (; indent > 0; --indent)
-            out << "  ";
-        return out;
+        out.fill(' ', 2 * indent);
     }
 
     struct yaml_printer final {
-        std::ostream& out;
-        const int indent;
+        yaml_writer& out;
 
         void operator()(const Null& value) const
         {
-            if (indent > 0)
-                out << ' ';
-
-            out << "null";
+            out.null();
         }
 
         void operator()(const True& value) const
         {
-            if (indent > 0)
-                out << ' ';
-
-            out << "true";
+            out.boolean(true);
         }
 
         void operator()(const False& value) const
         {
-            if (indent > 0)
-                out << ' ';
-
-            out << "false";
+            out.boolean(false);
         }
 
         void operator()(const String& value) const
         {
-            if (indent > 0)
-                out << ' ';
-
-            serialize_yaml(out, value.data);
+            out.string(value.data);
         }
 
         void operator()(const Number& value) const
         {
-            if (indent > 0)
-                out << ' ';
+            out.number(value);
+        }
 
-            out << value.data;
+        void operator()(const Object& value) const
+        {
+            out.begin_object();
+            for (const auto& m : value.data) {
+                out.key(m.first);
+                mpark::visit(*this, m.second);
+            }
+            out.end_object();
         }
 
-        void operator()(const Object& value) const;
-        void operator()(const Array& value) const;
+        void operator()(const Array& value) const
+        {
+            out.begin_array();
+            for (const auto& m : value.data) {
+                mpark::visit(*this, m);
+            }
+            out.end_array();
+        }
     };
+} // namespace
 
-    void visit(const Value& obj, std::ostream& out, int indent = 0)
-    {
-        mpark::visit(yaml_printer{ out, indent }, obj);
-    }
+yaml_writer::yaml_writer(std::ostream& out) : out_(out) {}
 
-    void yaml_printer::operator()(const Object& value) const
-    {
-        if (value.data.empty()) {
-            if (indent > 0)
-                out << ' ';
-            out << "{}";
-            return;
-        }
+void yaml_writer::begin_entry()
+{
+    assert(!open_.empty());
+    container& c = open_.back();
 
-        if (indent > 0)
-            out << '\n';
+    if (c.entries++ > 0)
+        out_.append('\n');
+    else if (c.indent > 0)
+        out_.append('\n');
 
-        int newlines = value.data.size() - 1;
-        for (const auto& m : value.data) {
-            do_indent(out, indent);
+    do_indent(out_, c.indent);
+}
 
-            // for clearer, unescaped reading
-            if (is_alphanum_dash(m.first))
-                out << m.first;
-            else
-                serialize_yaml(out, m.first);
+void yaml_writer::begin_value()
+{
+    if (!open_.empty() && open_.back().array) {
+        begin_entry();
+        out_.append('-');
+    }
+}
 
-            out << ":";
+void yaml_writer::begin_scalar()
+{
+    begin_value();
 
-            visit(m.second, out, indent + 1);
+    if (!open_.empty())
+        out_.append(' ');
+}
 
-            if (newlines > 0) {
-                out << '\n';
-                --newlines;
-            }
-        }
+void yaml_writer::end_container(const char* empty)
+{
+    assert(!open_.empty());
+    const container c = open_.back();
+    open_.pop_back();
+
+    if (c.entries == 0) {
+        if (c.indent > 0)
+            out_.append(' ');
+        out_.append(empty);
     }
+}
 
-    void yaml_printer::operator()(const Array& value) const
-    {
-        if (value.data.empty()) {
-            if (indent > 0)
-                out << ' ';
-            out << "[]";
-            return;
-        }
+void yaml_writer::begin_object()
+{
+    begin_value();
+    open_.push_back(container{ open_.size(), 0, false });
+}
 
-        if (indent > 0)
-            out << '\n';
+void yaml_writer::end_object()
+{
+    end_container("{}");
+}
 
-        int newlines = value.data.size() - 1;
-        for (const auto& m : value.data) {
-            do_indent(out, indent);
+void yaml_writer::begin_array()
+{
+    begin_value();
+    open_.push_back(container{ open_.size(), 0, true });
+}
 
-            out << '-';
+void yaml_writer::end_array()
+{
+    end_container("[]");
+}
 
-            visit(m, out, indent + 1);
+void yaml_writer::key(const std::string& key)
+{
+    assert(!open_.empty() && !open_.back().array);
+    begin_entry();
 
-            if (newlines > 0) {
-                out << '\n';
-                --newlines;
-            }
-        }
-    }
-} // namespace
+    // for clearer, unescaped reading
+    if (is_alphanum_dash(key))
+        out_.append(key);
+    else
+        quote_yaml_string(out_, key);
+
+    out_.append(":");
+}
+
+void yaml_writer::null()
+{
+    begin_scalar();
+    out_.append("null");
+}
+
+void yaml_writer::boolean(bool value)
+{
+    begin_scalar();
+    if (value)
+        out_.append("true");
+    else
+        out_.append("false");
+}
+
+void yaml_writer::string(const std::string& value)
+{
+    begin_scalar();
+    quote_yaml_string(out_, value);
+}
+
+void yaml_writer::number(const std::string& value)
+{
+    begin_scalar();
+    out_.append(value);
+}
+
+void yaml_writer::number(std::int64_t value)
+{
+    begin_scalar();
+    char buffer[number_chars];
+    out_.append(buffer, render_number(buffer, value));
+}
+
+void yaml_writer::number(double value)
+{
+    begin_scalar();
+    char buffer[number_chars];
+    out_.append(buffer, render_number(buffer, value));
+}
+
+void yaml_writer::number(const Number& value)
+{
+    mpark::visit(number_printer<yaml_writer>{ *this }, value.data);
+}
 
 std::ostream& so::serialize_yaml(std::ostream& out, const Value& obj)
 {
-    visit(obj, out);
+    yaml_writer writer(out);
+    mpark::visit(yaml_printer{ writer }, obj);
     return out;
 }
@@ -10,6 +10,10 @@
 #define DRAFTER_UTILS_SO_YAMLIO_H
 
 #include "Value.h"
+#include "OutputBuffer.h"
+
+#include <iosfwd>
+#include <vector>
 
 namespace drafter
 {
@@ -18,6 +22,51 @@ namespace drafter
         namespace so
         {
             std::ostream& serialize_yaml(std::ostream& out, const Value& obj);
+
+            ///
+            /// Streaming YAML writer
+            ///
+            /// Writes YAML tokens into the output stream, formatted exactly
+            /// the way serialize_yaml formats an equivalent Value. Object
+            /// members are written as key() followed by their value. Output
+            /// is buffered and flushed once the writer is destroyed.
+            ///
+            class yaml_writer
+            {
+                struct container {
+                    std::size_t indent;
+                    std::size_t entries;
+                    bool array;
+                };
+
+                output_buffer out_;
+                std::vector<container> open_;
+
+            public:
+                explicit yaml_writer(std::ostream& out);
+
+                void begin_object();
+                void end_object();
+
+                void begin_array();
+                void end_array();
+
+                void key(const std::string& key);
+
+                void null();
+                void boolean(bool value);
+                void string(const std::string& value);
+                void number(const std::string& value);
+                void number(std::int64_t value);
+                void number(double value);
+                void number(const Number& value);
+
+            private:
+                void begin_value();
+                void begin_scalar();
+                void begin_entry();
+                void end_container(const char* empty);
+            };
         }
     }
 }
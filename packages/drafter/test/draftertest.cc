@@ -12,11 +12,14 @@
 #include "stream.h"
 
 #include "refract/SerializeSo.h"
+#include "refract/SerializeStream.h"
 #include "utils/log/Trivial.h"
 #include "utils/so/JsonIo.h"
+#include "utils/so/YamlIo.h"
 
 #include "Serialize.h"
 #include "SerializeResult.h"
+#include "options.h"
 
 using namespace draftertest;
 
@@ -125,9 +128,36 @@ bool draftertest::handleResultJSON(const std::string& fixturePath, test_options
     std::ostringstream outStream;
     drafter::ConversionContext context(source.c_str(), nullptr, testOpts.test(TEST_OPTION_EXPAND_MSON));
 
+    // WrapRefract records conversion errors in the blueprint report
+    auto parallelBlueprint = blueprint;
+
     if (auto parsed = WrapRefract(blueprint, context)) {
         auto soValue = refract::serialize::renderSo(*parsed, testOpts.test(TEST_OPTION_SOURCEMAPS));
         drafter::utils::so::serialize_json(outStream, soValue);
+
+        // streaming serializers must be byte-identical with Simple Object path
+        std::ostringstream streamedJson;
+        refract::serialize::renderJson(streamedJson, *parsed, testOpts.test(TEST_OPTION_SOURCEMAPS));
+        REQUIRE(streamedJson.str() == outStream.str());
+
+        std::ostringstream soYaml;
+        std::ostringstream streamedYaml;
+        drafter::utils::so::serialize_yaml(soYaml, soValue);
+        refract::serialize::renderYaml(streamedYaml, *parsed, testOpts.test(TEST_OPTION_SOURCEMAPS));
+        REQUIRE(streamedYaml.str() == soYaml.str());
+
+        // parallel conversion must be byte-identical with the sequential one
+        drafter_parse_options parallelOptions{};
+        parallelOptions.flags.set(drafter_parse_options::PARALLEL_CONVERSION);
+        drafter::ConversionContext parallelContext(
+            source.c_str(), &parallelOptions, testOpts.test(TEST_OPTION_EXPAND_MSON));
+
+        auto parallel = WrapRefract(parallelBlueprint, parallelContext);
+        REQUIRE(parallel);
+
+        std::ostringstream parallelJson;
+        refract::serialize::renderJson(parallelJson, *parallel, testOpts.test(TEST_OPTION_SOURCEMAPS));
+        REQUIRE(parallelJson.str() == outStream.str());
     }
 
     outStream << "\n";
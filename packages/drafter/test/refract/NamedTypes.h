@@ -0,0 +1,70 @@
+//
+//  test/refract/NamedTypes.h
+//  test-librefract
+//
+//  Copyright (c) 2020 Apiary Inc. All rights reserved.
+//
+
+#ifndef DRAFTER_TEST_REFRACT_NAMEDTYPES_H
+#define DRAFTER_TEST_REFRACT_NAMEDTYPES_H
+
+#include "refract/Element.h"
+#include "refract/ExpandVisitor.h"
+#include "refract/Registry.h"
+#include "refract/Visitor.h"
+
+#include <memory>
+#include <string>
+
+namespace refracttest
+{
+    inline std::unique_ptr<refract::ObjectElement> namedObject(const std::string& name, const std::string& base)
+    {
+        auto result = refract::make_empty<refract::ObjectElement>();
+        result->element(base);
+        result->meta().set("id", refract::from_primitive(name));
+        return result;
+    }
+
+    inline std::unique_ptr<refract::IElement> reference(const std::string& name)
+    {
+        auto result = refract::make_empty<refract::ObjectElement>();
+        result->element(name);
+        return std::move(result);
+    }
+
+    inline std::unique_ptr<refract::IElement> property(const std::string& key, std::unique_ptr<refract::IElement> value)
+    {
+        return refract::make_element<refract::MemberElement>(refract::from_primitive(key), std::move(value));
+    }
+
+    // Registry of
+    // - Leaf (object): `leaf` (string)
+    // - Node (Leaf): `node` (Leaf)
+    // - Loop (object): `loop` (Loop)
+    inline void fillRegistry(refract::Registry& registry)
+    {
+        auto leaf = namedObject("Leaf", "object");
+        leaf->set(refract::dsd::Object{ property("leaf", refract::make_empty<refract::StringElement>()) });
+        registry.add(std::move(leaf));
+
+        auto node = namedObject("Node", "Leaf");
+        node->set(refract::dsd::Object{ property("node", reference("Leaf")) });
+        registry.add(std::move(node));
+
+        auto loop = namedObject("Loop", "object");
+        loop->set(refract::dsd::Object{ property("loop", reference("Loop")) });
+        registry.add(std::move(loop));
+    }
+
+    inline std::unique_ptr<refract::IElement> expand(const refract::IElement& e,
+        const refract::Registry& registry,
+        refract::ExpandedTypes* cache = nullptr)
+    {
+        refract::ExpandVisitor expander(registry, cache);
+        refract::VisitBy(e, expander);
+        return expander.get();
+    }
+} // namespace refracttest
+
+#endif
@@ -1144,3 +1144,71 @@ SCENARIO("Extend::merge behaves as expected", "[Element][Extend][merge]")
         }
     }
 }
+
+SCENARIO("Extend::merge keeps the order of overridden entries", "[Element][Extend][merge]")
+{
+    GIVEN("A Extend with three object elements overriding each other's members")
+    {
+        auto extend = make_element<ExtendElement>(   //
+            make_element<ObjectElement>(             //
+                make_element<MemberElement>("a", from_primitive(1)),
+                make_element<RefElement>("Mixin"),
+                make_element<MemberElement>("b", from_primitive(1)),
+                make_element<MemberElement>("c", from_primitive(1))),
+            make_element<ObjectElement>( //
+                make_element<MemberElement>("c", from_primitive(2)),
+                make_element<MemberElement>("d", from_primitive(2)),
+                make_element<RefElement>("Mixin")),
+            make_element<ObjectElement>( //
+                make_element<MemberElement>("d", from_primitive(3)),
+                make_element<MemberElement>("a", from_primitive(3))));
+
+        WHEN("it is merged")
+        {
+            auto merged = extend->get().merge();
+
+            THEN("overridden entries stay in place and new ones are appended")
+            {
+                auto expected = make_element<ObjectElement>( //
+                    make_element<MemberElement>("a", from_primitive(3)),
+                    make_element<RefElement>("Mixin"),
+                    make_element<MemberElement>("b", from_primitive(1)),
+                    make_element<MemberElement>("c", from_primitive(2)),
+                    make_element<MemberElement>("d", from_primitive(3)));
+
+                REQUIRE(merged);
+                REQUIRE(*merged == *expected);
+            }
+        }
+    }
+
+    GIVEN("A Extend with two enum elements sharing some enumerations")
+    {
+        auto first = make_empty<EnumElement>();
+        first->attributes().set("enumerations",
+            make_element<ArrayElement>(from_primitive("x"), from_primitive("y"), from_primitive("z")));
+
+        auto second = make_empty<EnumElement>();
+        second->attributes().set("enumerations",
+            make_element<ArrayElement>(from_primitive("y"), from_primitive("w"), from_primitive("x")));
+
+        auto extend = make_element<ExtendElement>(std::move(first), std::move(second));
+
+        WHEN("it is merged")
+        {
+            auto merged = extend->get().merge();
+
+            THEN("shared enumerations are moved to the end in the order of the latter")
+            {
+                REQUIRE(merged);
+
+                auto it = merged->attributes().find("enumerations");
+                REQUIRE(it != merged->attributes().end());
+
+                auto expected = make_element<ArrayElement>(
+                    from_primitive("z"), from_primitive("y"), from_primitive("w"), from_primitive("x"));
+                REQUIRE(*it->second == *expected);
+            }
+        }
+    }
+}
@@ -198,3 +198,82 @@ SCENARIO("InfoElementss can be copied and moved", "[InfoElements]")
         }
     }
 }
+
+SCENARIO("InfoElements keep insertion order beyond their inline capacity", "[InfoElements]")
+{
+    GIVEN("InfoElements with more entries than held inline")
+    {
+        InfoElements collection;
+        const std::size_t count = InfoElements::inline_capacity + 3;
+        for (std::size_t i = 0; i < count; ++i)
+            collection.set(std::to_string(i), from_primitive(std::to_string(i)));
+
+        THEN("all entries are found in insertion order")
+        {
+            REQUIRE(collection.size() == count);
+
+            std::size_t i = 0;
+            for (const auto& entry : collection)
+                REQUIRE(entry.first == std::to_string(i++));
+        }
+
+        WHEN("an entry is erased from the middle")
+        {
+            collection.erase("1");
+
+            THEN("the remaining entries keep their order")
+            {
+                REQUIRE(collection.size() == count - 1);
+                REQUIRE(collection.begin()->first == "0");
+                REQUIRE(std::next(collection.begin())->first == "2");
+                REQUIRE(collection.find("1") == collection.end());
+            }
+        }
+
+        WHEN("it is moved")
+        {
+            InfoElements moved(std::move(collection));
+
+            THEN("the entries are moved along")
+            {
+                REQUIRE(collection.empty());
+                REQUIRE(moved.size() == count);
+                REQUIRE(moved.find("4") != moved.end());
+            }
+        }
+
+        WHEN("it is cleared and refilled")
+        {
+            collection.clear();
+            collection.set("id", from_primitive("foo"));
+
+            THEN("it holds just the new entry")
+            {
+                REQUIRE(collection.size() == 1);
+                REQUIRE(collection.begin()->first == "id");
+            }
+        }
+    }
+}
+
+SCENARIO("Cloning an Element without meta id", "[InfoElements][Element]")
+{
+    GIVEN("an Element with an id and a description")
+    {
+        auto element = make_element<StringElement>("foo");
+        element->meta().set("id", from_primitive("Named"));
+        element->meta().set("description", from_primitive("Lorem"));
+
+        WHEN("it is cloned with cNoMetaId")
+        {
+            auto cloned = element->clone(IElement::cAll | IElement::cNoMetaId);
+
+            THEN("the clone has all meta but the id")
+            {
+                REQUIRE(cloned->meta().size() == 1);
+                REQUIRE(cloned->meta().find("id") == cloned->meta().end());
+                REQUIRE(cloned->meta().find("description") != cloned->meta().end());
+            }
+        }
+    }
+}
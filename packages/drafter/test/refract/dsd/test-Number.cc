@@ -150,3 +150,41 @@ SCENARIO("number DSDs are tested for equality and inequality", "[Element][Number
         }
     }
 }
+
+SCENARIO("Number is constructed from native values", "[ElementData][Number]")
+{
+    GIVEN("A Number constructed from the integer 42")
+    {
+        Number number(42);
+
+        THEN("its data renders as `42`")
+        {
+            REQUIRE(number.get() == "42");
+        }
+
+        THEN("it converts back to 42")
+        {
+            REQUIRE(std::int64_t{ number } == 42);
+        }
+
+        THEN("it equals a Number constructed from the literal `42`")
+        {
+            REQUIRE(number == Number("42"));
+        }
+    }
+
+    GIVEN("A Number constructed from the literal `1.50`")
+    {
+        Number number("1.50");
+
+        THEN("its data is kept verbatim")
+        {
+            REQUIRE(number.get() == "1.50");
+        }
+
+        THEN("it converts to 1")
+        {
+            REQUIRE(std::int64_t{ number } == 1);
+        }
+    }
+}
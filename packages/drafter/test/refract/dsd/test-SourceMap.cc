@@ -0,0 +1,82 @@
+//
+//  test/refract/dsd/test-SourceMap.cc
+//  test-librefract
+//
+//  Copyright (c) 2020 Apiary Inc. All rights reserved.
+//
+
+#include <catch2/catch.hpp>
+
+#include "refract/Element.h"
+#include "refract/ElementUtils.h"
+#include "refract/dsd/SourceMap.h"
+
+using namespace refract;
+using namespace dsd;
+
+TEST_CASE("`SourceMap`'s default element name is `sourceMap`", "[Element][SourceMap]")
+{
+    REQUIRE(std::string(SourceMap::name) == "sourceMap");
+    REQUIRE(make_empty<SourceMapElement>()->element() == "sourceMap");
+}
+
+SCENARIO("`SourceMap` is constructed from ranges and compared", "[ElementData][SourceMap]")
+{
+    GIVEN("A default initialized SourceMap")
+    {
+        SourceMap sourceMap;
+
+        THEN("it has neither ranges nor positions")
+        {
+            REQUIRE(sourceMap.ranges().empty());
+            REQUIRE(sourceMap.positions().empty());
+        }
+    }
+
+    GIVEN("A SourceMap constructed from ranges")
+    {
+        SourceMap sourceMap({ { 3, 5 }, { 12, 1 } });
+
+        THEN("it holds the ranges in order")
+        {
+            REQUIRE(sourceMap.ranges().size() == 2);
+            REQUIRE(sourceMap.ranges()[0].location == 3);
+            REQUIRE(sourceMap.ranges()[0].length == 5);
+            REQUIRE(sourceMap.ranges()[1].location == 12);
+            REQUIRE(sourceMap.ranges()[1].length == 1);
+            REQUIRE(sourceMap.positions().empty());
+        }
+
+        THEN("it equals a SourceMap of the same ranges")
+        {
+            REQUIRE(sourceMap == SourceMap({ { 3, 5 }, { 12, 1 } }));
+        }
+
+        THEN("it does not equal a SourceMap of other ranges")
+        {
+            REQUIRE(sourceMap != SourceMap({ { 3, 5 } }));
+            REQUIRE(sourceMap != SourceMap({ { 3, 5 }, { 12, 2 } }));
+        }
+
+        THEN("it does not equal a SourceMap of the same ranges with positions")
+        {
+            REQUIRE(sourceMap != SourceMap({ { 3, 5 }, { 12, 1 } }, { { 1, 4, 2, 2 }, { 3, 1, 3, 1 } }));
+        }
+    }
+
+    GIVEN("A SourceMap Element")
+    {
+        auto element = make_element<SourceMapElement>(std::vector<SourceMap::Range>{ { 3, 5 } });
+
+        THEN("it is tagged as such")
+        {
+            REQUIRE(element->type() == ElementType::SourceMap);
+            REQUIRE(get<const SourceMapElement>(static_cast<const IElement*>(element.get())));
+        }
+
+        THEN("its clone equals it")
+        {
+            REQUIRE(*element->clone() == *element);
+        }
+    }
+}
@@ -0,0 +1,151 @@
+//
+//  test/refract/test-Arena.cc
+//  test-librefract
+//
+//  Copyright (c) 2020 Apiary Inc. All rights reserved.
+//
+
+#include <catch2/catch.hpp>
+
+#include "refract/Arena.h"
+#include "refract/Element.h"
+
+using namespace refract;
+
+namespace
+{
+    std::unique_ptr<ArrayElement> sampleTree(std::size_t members)
+    {
+        auto result = make_element<ArrayElement>();
+        for (std::size_t i = 0; i < members; ++i) {
+            auto obj = make_element<ObjectElement>(make_element<MemberElement>("id", from_primitive(i)),
+                make_element<MemberElement>("name", from_primitive("some reasonably long name, no SSO here")));
+            obj->meta().set("id", from_primitive("Sample"));
+            result->get().push_back(std::move(obj));
+        }
+        return result;
+    }
+} // namespace
+
+SCENARIO("Elements are allocated from the active arena", "[Element][arena]")
+{
+    GIVEN("an arena")
+    {
+        Arena arena;
+
+        WHEN("an element is created without an active scope")
+        {
+            auto e = make_element<StringElement>("foo");
+
+            THEN("it is heap allocated")
+            {
+                REQUIRE(!arena.owns(*e));
+                REQUIRE(arena.allocations() == 0);
+            }
+        }
+
+        WHEN("an element is created within a scope")
+        {
+            ArenaScope scope(&arena);
+            auto e = make_element<StringElement>("foo");
+
+            THEN("it is allocated from the arena")
+            {
+                REQUIRE(arena.owns(*e));
+                REQUIRE(arena.allocations() == 1);
+            }
+
+            THEN("its clones made outside of the scope are heap allocated")
+            {
+                std::unique_ptr<IElement> c;
+                {
+                    ArenaScope heapScope(nullptr);
+                    c = e->clone();
+                }
+                REQUIRE(!arena.owns(*c));
+            }
+        }
+
+        WHEN("scopes are nested")
+        {
+            Arena inner;
+            ArenaScope outerScope(&arena);
+
+            auto a = make_element<NullElement>();
+            {
+                ArenaScope innerScope(&inner);
+                auto b = make_element<NullElement>();
+                {
+                    ArenaScope heapScope(nullptr);
+                    auto c = make_element<NullElement>();
+
+                    THEN("elements come from the innermost scope")
+                    {
+                        REQUIRE(arena.owns(*a));
+                        REQUIRE(inner.owns(*b));
+                        REQUIRE(!arena.owns(*c));
+                        REQUIRE(!inner.owns(*c));
+                    }
+                }
+                REQUIRE(ArenaScope::current() == &inner);
+            }
+            REQUIRE(ArenaScope::current() == &arena);
+        }
+
+        REQUIRE(ArenaScope::current() == nullptr);
+    }
+}
+
+SCENARIO("Arena serves element trees from few heap blocks", "[Element][arena]")
+{
+    GIVEN("a large tree built within an arena scope")
+    {
+        Arena arena;
+        ArenaScope scope(&arena);
+        auto tree = sampleTree(10000);
+
+        THEN("every element is allocated from the arena")
+        {
+            // root + per entry: object, its id and 2 members with a key and value each
+            REQUIRE(arena.allocations() == 1 + 10000 * 8);
+        }
+
+        THEN("it holds equal data as the heap allocated tree")
+        {
+            std::unique_ptr<ArrayElement> heapTree;
+            {
+                ArenaScope heapScope(nullptr);
+                heapTree = sampleTree(10000);
+            }
+            REQUIRE(tree->get().size() == heapTree->get().size());
+            REQUIRE(arena.owns(*tree->get().begin()[9999]));
+            REQUIRE(!arena.owns(*heapTree->get().begin()[9999]));
+        }
+
+        WHEN("the tree is released")
+        {
+            tree.reset();
+
+            THEN("arena memory is kept until the arena is destroyed")
+            {
+                REQUIRE(arena.reserved() > 0);
+            }
+        }
+    }
+
+    GIVEN("an oversized allocation")
+    {
+        Arena arena(1024);
+        const void* small = arena.allocate(16);
+        const void* large = arena.allocate(4096);
+        const void* next = arena.allocate(16);
+
+        THEN("it is served from a dedicated block")
+        {
+            REQUIRE(static_cast<const char*>(next) == static_cast<const char*>(small) + 16);
+            REQUIRE(arena.owns(large));
+            REQUIRE(arena.owns(static_cast<const char*>(large) + 4095));
+            REQUIRE(arena.reserved() == 1024 + 4096);
+        }
+    }
+}
@@ -0,0 +1,162 @@
+//
+//  test/refract/test-ExpandVisitor.cc
+//  test-librefract
+//
+//  Copyright (c) 2020 Apiary Inc. All rights reserved.
+//
+
+#include <catch2/catch.hpp>
+
+#include "refract/Element.h"
+#include "refract/ElementUtils.h"
+#include "refract/ExpandVisitor.h"
+#include "refract/Registry.h"
+#include "refract/Utils.h"
+
+#include "NamedTypes.h"
+
+using namespace refract;
+using namespace refracttest;
+
+namespace
+{
+    // object nesting `depth` levels of `inner` members around `leaf`
+    std::unique_ptr<IElement> nested(std::size_t depth, std::unique_ptr<IElement> leaf)
+    {
+        auto result = std::move(leaf);
+        for (std::size_t i = 0; i < depth; ++i)
+            result = make_element<ObjectElement>(property("inner", std::move(result)));
+        return result;
+    }
+} // namespace
+
+SCENARIO("Named types are expanded once and cached", "[ExpandVisitor]")
+{
+    Registry registry;
+    fillRegistry(registry);
+
+    GIVEN("an element referencing named types through inheritance and members")
+    {
+        auto element = make_element<ObjectElement>(property("a", reference("Node")), property("b", reference("Loop")));
+
+        WHEN("it is expanded with and without a cache")
+        {
+            ExpandedTypes cache;
+
+            auto expected = expand(*element, registry, nullptr);
+            auto first = expand(*element, registry, &cache);
+            auto second = expand(*element, registry, &cache);
+
+            THEN("all expansions are equal")
+            {
+                REQUIRE(expected);
+                REQUIRE(first);
+                REQUIRE(second);
+                REQUIRE(*expected == *first);
+                REQUIRE(*expected == *second);
+            }
+
+            THEN("expanded named types are cached")
+            {
+                REQUIRE(cache.find(Symbol("Node")));
+                REQUIRE(cache.find(Symbol("Leaf")));
+                REQUIRE(cache.find(Symbol("Loop")));
+            }
+        }
+    }
+
+    GIVEN("a cache filled by expanding the circular type directly")
+    {
+        ExpandedTypes cache;
+        auto loop = reference("Loop");
+        expand(*loop, registry, &cache);
+
+        WHEN("an element nesting the circular type is expanded")
+        {
+            auto element = make_element<ObjectElement>(property("a", reference("Loop")));
+
+            auto expected = expand(*element, registry, nullptr);
+            auto actual = expand(*element, registry, &cache);
+
+            THEN("the expansion equals the uncached one")
+            {
+                REQUIRE(expected);
+                REQUIRE(actual);
+                REQUIRE(*expected == *actual);
+            }
+        }
+    }
+}
+
+SCENARIO("Deeply nested data structures are expanded", "[ExpandVisitor]")
+{
+    Registry registry;
+    fillRegistry(registry);
+
+    GIVEN("a deep object without named types")
+    {
+        auto element = nested(256, make_empty<StringElement>());
+
+        THEN("it is not expanded")
+        {
+            REQUIRE(!expand(*element, registry, nullptr));
+        }
+    }
+
+    GIVEN("a deep object referencing a named type at its bottom")
+    {
+        auto element = nested(256, reference("Leaf"));
+
+        WHEN("it is expanded")
+        {
+            auto expanded = expand(*element, registry, nullptr);
+
+            THEN("the named type is expanded at the bottom")
+            {
+                REQUIRE(expanded);
+
+                const IElement* e = expanded.get();
+                for (std::size_t i = 0; i < 256; ++i) {
+                    const auto* object = get<const ObjectElement>(e);
+                    REQUIRE(object);
+                    const auto* member = get<const MemberElement>(object->get().begin()->get());
+                    REQUIRE(member);
+                    e = member->get().value();
+                }
+
+                REQUIRE(get<const ExtendElement>(e));
+            }
+        }
+    }
+}
+
+SCENARIO("An ExpandVisitor is reused for several elements", "[ExpandVisitor]")
+{
+    Registry registry;
+    fillRegistry(registry);
+
+    GIVEN("an ExpandVisitor that visited an element without named types")
+    {
+        ExpandVisitor expander(registry);
+        {
+            auto plain = make_element<ObjectElement>(property("a", make_empty<ObjectElement>()));
+            VisitBy(*plain, expander);
+            REQUIRE(!expander.get());
+        }
+
+        WHEN("it visits an element of the same shape referencing a named type")
+        {
+            auto element = make_element<ObjectElement>(property("a", reference("Leaf")));
+            VisitBy(*element, expander);
+            auto expanded = expander.get();
+
+            THEN("the element is expanded as by a new ExpandVisitor")
+            {
+                auto expected = expand(*element, registry);
+                REQUIRE(expected);
+                REQUIRE(expanded);
+                REQUIRE(*expanded == *expected);
+            }
+        }
+    }
+}
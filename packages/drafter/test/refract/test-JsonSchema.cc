@@ -10,8 +10,12 @@
 
 #include "refract/JsonSchema.h"
 #include "refract/Element.h"
+#include "refract/ExpandVisitor.h"
+#include "refract/Registry.h"
 #include "utils/so/JsonIo.h"
 
+#include "NamedTypes.h"
+
 #include <chrono>
 #include <sstream>
 
@@ -19,6 +23,7 @@ using namespace drafter::utils;
 using namespace so;
 using namespace std::chrono;
 using namespace refract;
+using namespace refracttest;
 
 namespace
 {
@@ -735,3 +740,88 @@ SCENARIO("JSON Schema serialization of ObjectElement", "[json-schema]")
         }
     }
 }
+
+SCENARIO("JSON Schema serialization with named types in definitions", "[json-schema][definitions]")
+{
+    Registry registry;
+    fillRegistry(registry);
+
+    GIVEN("An expanded ObjectElement using inherited and circular named types")
+    {
+        auto el = expand(
+            *make_element<ObjectElement>(
+                property("a", reference("Node")), property("b", reference("Node")), property("c", reference("Loop"))),
+            registry);
+        REQUIRE(el);
+
+        WHEN("a JSON Schema is generated from it with definitions")
+        {
+            auto result = schema::generateJsonSchema(*el, schema::NamedTypes::Definitions);
+
+            THEN("each named type is defined once and referred to by $ref")
+            {
+                REQUIRE(to_string(result) == R"({"$schema":"http://json-schema.org/draft-07/schema#","type":"object","properties":{"a":{"$ref":"#/definitions/Node"},"b":{"$ref":"#/definitions/Node"},"c":{"$ref":"#/definitions/Loop"}},"definitions":{"Node":{"type":"object","properties":{"leaf":{"type":"string"},"node":{"$ref":"#/definitions/Leaf"}}},"Leaf":{"type":"object","properties":{"leaf":{"type":"string"}}},"Loop":{"type":"object","properties":{"loop":{"$ref":"#/definitions/Loop"}}}}})");
+            }
+        }
+
+        WHEN("a JSON Schema is generated from it inlining named types")
+        {
+            auto result = schema::generateJsonSchema(*el);
+
+            THEN("the circular named type is cut off")
+            {
+                REQUIRE(to_string(result) == R"({"$schema":"http://json-schema.org/draft-07/schema#","type":"object","properties":{"a":{"type":"object","properties":{"leaf":{"type":"string"},"node":{"type":"object","properties":{"leaf":{"type":"string"}}}}},"b":{"type":"object","properties":{"leaf":{"type":"string"},"node":{"type":"object","properties":{"leaf":{"type":"string"}}}}},"c":{"type":"object","properties":{"loop":{"type":"object"}}}}})");
+            }
+        }
+    }
+
+    GIVEN("An expanded circular named type")
+    {
+        auto el = expand(*reference("Loop"), registry);
+        REQUIRE(el);
+
+        WHEN("a JSON Schema is generated from it with definitions")
+        {
+            auto result = schema::generateJsonSchema(*el, schema::NamedTypes::Definitions);
+
+            THEN("the schema renders it in full and defines it for the circular reference")
+            {
+                REQUIRE(to_string(result) == R"({"$schema":"http://json-schema.org/draft-07/schema#","type":"object","properties":{"loop":{"$ref":"#/definitions/Loop"}},"definitions":{"Loop":{"type":"object","properties":{"loop":{"$ref":"#/definitions/Loop"}}}}})");
+            }
+        }
+    }
+
+    GIVEN("An expanded named type refined by a fixed type attribute")
+    {
+        auto node = reference("Leaf");
+        node->attributes().set("typeAttributes", make_element<ArrayElement>(from_primitive("fixed")));
+        auto el = expand(*make_element<ObjectElement>(property("a", std::move(node))), registry);
+        REQUIRE(el);
+
+        WHEN("a JSON Schema is generated from it with definitions")
+        {
+            auto result = schema::generateJsonSchema(*el, schema::NamedTypes::Definitions);
+
+            THEN("the refined named type is rendered in full and not defined")
+            {
+                REQUIRE(to_string(result) == R"({"$schema":"http://json-schema.org/draft-07/schema#","type":"object","properties":{"a":{"type":"object","properties":{"leaf":{"type":"string"}},"required":["leaf"],"additionalProperties":false}}})");
+            }
+        }
+    }
+
+    GIVEN("An expanded named type using another one")
+    {
+        auto el = expand(*reference("Node"), registry);
+        REQUIRE(el);
+
+        WHEN("a JSON Schema is generated from it with definitions")
+        {
+            auto result = schema::generateJsonSchema(*el, schema::NamedTypes::Definitions);
+
+            THEN("the schema renders it in full and defines only the named type referred to")
+            {
+                REQUIRE(to_string(result) == R"({"$schema":"http://json-schema.org/draft-07/schema#","type":"object","properties":{"leaf":{"type":"string"},"node":{"$ref":"#/definitions/Leaf"}},"definitions":{"Leaf":{"type":"object","properties":{"leaf":{"type":"string"}}}}})");
+            }
+        }
+    }
+}
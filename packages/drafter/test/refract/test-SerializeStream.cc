@@ -0,0 +1,185 @@
+//
+//  test/refract/test-SerializeStream.cc
+//  test-librefract
+//
+//  Copyright (c) 2020 Apiary Inc. All rights reserved.
+//
+
+#include <catch2/catch.hpp>
+
+#include "refract/Element.h"
+#include "refract/SerializeSo.h"
+#include "refract/SerializeStream.h"
+#include "utils/so/JsonIo.h"
+#include "utils/so/YamlIo.h"
+
+#include <sstream>
+
+using namespace refract;
+using namespace drafter::utils;
+
+namespace
+{
+    std::unique_ptr<IElement> sampleTree()
+    {
+        auto annotation = make_element<StringElement>("some \"quoted\"\nwarning");
+        annotation->element("annotation");
+        annotation->meta().set("classes", make_element<ArrayElement>(from_primitive("warning")));
+        annotation->attributes().set("code", from_primitive(3));
+        annotation->attributes().set("sourceMap", make_element<ArrayElement>(from_primitive(1)));
+
+        auto obj = make_element<ObjectElement>( //
+            make_element<MemberElement>("name", from_primitive("Ünïcode \\ \t")),
+            make_element<MemberElement>("age", from_primitive(42)),
+            make_element<MemberElement>("flag", from_primitive(true)),
+            make_element<MemberElement>("nothing", make_element<NullElement>()),
+            make_empty<MemberElement>(),
+            make_element<MemberElement>("list", make_element<ArrayElement>()),
+            make_element<MemberElement>("ref", make_element<RefElement>("Other")));
+        obj->meta().set("id", from_primitive("Sample"));
+        obj->meta().set("sourceMap", make_element<ArrayElement>(from_primitive(2)));
+
+        auto result = make_element<ArrayElement>(std::move(obj),
+            make_element<EnumElement>(from_primitive("selected")),
+            make_empty<StringElement>(),
+            std::move(annotation));
+        result->element("parseResult");
+
+        return std::move(result);
+    }
+
+    std::string viaSoJson(const IElement& e, bool sourceMaps)
+    {
+        std::ostringstream out;
+        so::serialize_json(out, serialize::renderSo(e, sourceMaps));
+        return out.str();
+    }
+
+    std::string viaSoYaml(const IElement& e, bool sourceMaps)
+    {
+        std::ostringstream out;
+        so::serialize_yaml(out, serialize::renderSo(e, sourceMaps));
+        return out.str();
+    }
+
+    std::string streamedJson(const IElement& e, bool sourceMaps)
+    {
+        std::ostringstream out;
+        serialize::renderJson(out, e, sourceMaps);
+        return out.str();
+    }
+
+    std::string streamedYaml(const IElement& e, bool sourceMaps)
+    {
+        std::ostringstream out;
+        serialize::renderYaml(out, e, sourceMaps);
+        return out.str();
+    }
+} // namespace
+
+SCENARIO("Streaming serializers produce the same output as the Simple Object path", "[serialize][stream]")
+{
+    GIVEN("an API Elements tree")
+    {
+        auto tree = sampleTree();
+
+        THEN("streamed JSON without source maps is identical")
+        {
+            REQUIRE(streamedJson(*tree, false) == viaSoJson(*tree, false));
+        }
+
+        THEN("streamed JSON with source maps is identical")
+        {
+            REQUIRE(streamedJson(*tree, true) == viaSoJson(*tree, true));
+        }
+
+        THEN("streamed YAML without source maps is identical")
+        {
+            REQUIRE(streamedYaml(*tree, false) == viaSoYaml(*tree, false));
+        }
+
+        THEN("streamed YAML with source maps is identical")
+        {
+            REQUIRE(streamedYaml(*tree, true) == viaSoYaml(*tree, true));
+        }
+    }
+
+    GIVEN("an empty element")
+    {
+        auto e = make_empty<ObjectElement>();
+
+        THEN("streamed JSON is identical")
+        {
+            REQUIRE(streamedJson(*e, false) == viaSoJson(*e, false));
+        }
+
+        THEN("streamed YAML is identical")
+        {
+            REQUIRE(streamedYaml(*e, false) == viaSoYaml(*e, false));
+        }
+    }
+}
+
+namespace
+{
+    // Source map attribute as built before SourceMapElement existed
+    std::unique_ptr<IElement> expandedSourceMap(bool positions)
+    {
+        auto number = [positions](std::size_t value, std::size_t line, std::size_t column) {
+            auto result = make_element<NumberElement>(value);
+            if (positions) {
+                result->attributes().set("line", from_primitive(line));
+                result->attributes().set("column", from_primitive(column));
+            }
+            return result;
+        };
+
+        auto sourceMap = make_element<ArrayElement>( //
+            make_element<ArrayElement>(number(3, 1, 4), number(5, 2, 2)),
+            make_element<ArrayElement>(number(12, 3, 1), number(1, 3, 1)));
+        sourceMap->element("sourceMap");
+
+        return make_element<ArrayElement>(std::move(sourceMap));
+    }
+
+    std::unique_ptr<IElement> compactSourceMap(bool positions)
+    {
+        std::vector<dsd::SourceMap::Range> ranges{ { 3, 5 }, { 12, 1 } };
+
+        if (!positions)
+            return make_element<ArrayElement>(make_element<SourceMapElement>(std::move(ranges)));
+
+        std::vector<dsd::SourceMap::Position> lines{ { 1, 4, 2, 2 }, { 3, 1, 3, 1 } };
+        return make_element<ArrayElement>(make_element<SourceMapElement>(std::move(ranges), std::move(lines)));
+    }
+
+    std::unique_ptr<IElement> withSourceMap(std::unique_ptr<IElement> sourceMap)
+    {
+        auto result = from_primitive("mapped");
+        result->attributes().set("sourceMap", std::move(sourceMap));
+        return std::move(result);
+    }
+} // namespace
+
+SCENARIO("Source Map Elements are serialized in the API Elements source map shape", "[serialize][stream][sourceMap]")
+{
+    const bool positions = GENERATE(false, true);
+
+    GIVEN((positions ? "a source map with lines and columns" : "a source map"))
+    {
+        auto expanded = withSourceMap(expandedSourceMap(positions));
+        auto compact = withSourceMap(compactSourceMap(positions));
+
+        THEN("JSON is identical to the one of the expanded source map")
+        {
+            REQUIRE(streamedJson(*compact, true) == streamedJson(*expanded, true));
+            REQUIRE(viaSoJson(*compact, true) == viaSoJson(*expanded, true));
+        }
+
+        THEN("YAML is identical to the one of the expanded source map")
+        {
+            REQUIRE(streamedYaml(*compact, true) == streamedYaml(*expanded, true));
+            REQUIRE(viaSoYaml(*compact, true) == viaSoYaml(*expanded, true));
+        }
+    }
+}
@@ -0,0 +1,78 @@
+//
+//  test/refract/test-Symbol.cc
+//  test-librefract
+//
+//  Copyright (c) 2020 Apiary Inc. All rights reserved.
+//
+
+#include <catch2/catch.hpp>
+
+#include "refract/Element.h"
+#include "refract/Registry.h"
+#include "refract/Symbol.h"
+
+#include <sstream>
+
+using namespace refract;
+
+TEST_CASE("Well-known names are interned to the same Symbol", "[Symbol]")
+{
+    const Symbol a("object");
+    const Symbol b(std::string("object"));
+
+    REQUIRE(a == b);
+    REQUIRE(&a.str() == &b.str());
+    REQUIRE(a != Symbol("string"));
+}
+
+TEST_CASE("Other names are shared by copies and compared by content", "[Symbol]")
+{
+    const Symbol a("Named by test-Symbol");
+    const Symbol copy = a;
+    const Symbol b(std::string("Named by test-Symbol"));
+
+    REQUIRE(&copy.str() == &a.str());
+    REQUIRE(a == b);
+    REQUIRE(a.hash() == b.hash());
+    REQUIRE(a != Symbol("Other by test-Symbol"));
+    REQUIRE(a != Symbol("object"));
+
+    REQUIRE(a == "Named by test-Symbol");
+    REQUIRE(a == std::string("Named by test-Symbol"));
+    REQUIRE(a != "other");
+
+    std::ostringstream out;
+    out << a;
+    REQUIRE(out.str() == "Named by test-Symbol");
+}
+
+TEST_CASE("Default Symbol is the empty string", "[Symbol]")
+{
+    REQUIRE(Symbol().empty());
+    REQUIRE(Symbol() == Symbol(""));
+}
+
+TEST_CASE("Element names are Symbols", "[Symbol][Element]")
+{
+    auto str = make_empty<StringElement>();
+    REQUIRE(str->element() == Symbol("string"));
+
+    str->element("Name");
+    REQUIRE(str->element() == Symbol("Name"));
+    REQUIRE(str->clone()->element() == str->element());
+}
+
+TEST_CASE("Registry finds named types by Symbol or string", "[Symbol][Registry]")
+{
+    Registry registry;
+
+    auto named = make_empty<ObjectElement>();
+    named->meta().set("id", from_primitive("Registered by test-Symbol"));
+    REQUIRE(registry.add(std::move(named)));
+
+    REQUIRE(registry.find(Symbol("Registered by test-Symbol")));
+    REQUIRE(registry.find(std::string("Registered by test-Symbol")));
+    REQUIRE(!registry.find(std::string("Unregistered by test-Symbol")));
+    REQUIRE(isReserved(Symbol("object")));
+    REQUIRE(!isReserved(Symbol("Registered by test-Symbol")));
+}
@@ -10,6 +10,7 @@
 #include <catch2/catch.hpp>
 #include "refract/Element.h"
 
+#include "refract/ElementUtils.h"
 #include "refract/Utils.h"
 
 using namespace refract;
@@ -316,3 +317,17 @@ SCENARIO("Elements are tested for equality", "[Element][utils]")
         }
     }
 }
+
+TEST_CASE("Elements are tagged with their type", "[Element][utils]")
+{
+    auto str = from_primitive("foo");
+    auto obj = make_empty<ObjectElement>();
+
+    REQUIRE(str->type() == ElementType::String);
+    REQUIRE(obj->type() == ElementType::Object);
+
+    REQUIRE(get<StringElement>(str.get()) == str.get());
+    REQUIRE(get<const StringElement>(static_cast<const IElement*>(str.get())) == str.get());
+    REQUIRE(get<ObjectElement>(str.get()) == nullptr);
+    REQUIRE(get<StringElement>(static_cast<IElement*>(nullptr)) == nullptr);
+}
@@ -95,6 +95,22 @@ TEST_CASE("It should invoke Functor for member of container elements", "[Visitor
     REQUIRE(f.SCounter == 0);
 }
 
+TEST_CASE("It should dispatch content to specific operator through a copied Visitor", "[Visitor]")
+{
+    Functor f;
+    refract::Visitor v(f);
+    refract::Visitor copy(v);
+
+    auto str = from_primitive("Ehlo");
+    auto num = from_primitive(42);
+
+    str->content(copy);
+    num->content(copy);
+
+    REQUIRE(f.GCounter == 1);
+    REQUIRE(f.SCounter == 1);
+}
+
 // TEST_CASE("It should recognize Element Type by `Is` type operand", "[Visitor]")
 //{
 //    IElement* e = IElement::Create("xxxx");
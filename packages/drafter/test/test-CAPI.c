@@ -44,6 +44,172 @@ int test_parse_and_serialize()
     return 0;
 };
 
+typedef struct {
+    char data[4096];
+    size_t size;
+} write_buffer;
+
+size_t write_to_buffer(const char* data, size_t size, void* context)
+{
+    write_buffer* buffer = (write_buffer*)context;
+
+    if (buffer->size + size >= sizeof(buffer->data))
+        return 0;
+
+    memcpy(buffer->data + buffer->size, data, size);
+    buffer->size += size;
+    buffer->data[buffer->size] = '\0';
+
+    return size;
+}
+
+size_t reject_write(const char* data, size_t size, void* context)
+{
+    return 0;
+}
+
+int test_serialize_to_callback()
+{
+    drafter_result* result = NULL;
+    write_buffer buffer = { { 0 }, 0 };
+
+    REQUIRE(drafter_parse_blueprint(source, &result, NULL) == 0);
+    REQUIRE(result);
+
+    REQUIRE(drafter_serialize_to(result, write_to_buffer, &buffer, NULL) == DRAFTER_OK);
+
+    char* out = drafter_serialize(result, NULL);
+    REQUIRE(out);
+    REQUIRE(strcmp(out, buffer.data) == 0);
+
+    REQUIRE(drafter_serialize_to(result, reject_write, NULL, NULL) == DRAFTER_EINVALID_OUTPUT);
+    REQUIRE(drafter_serialize_to(result, NULL, NULL, NULL) == DRAFTER_EINVALID_OUTPUT);
+    REQUIRE(drafter_serialize_to(NULL, write_to_buffer, &buffer, NULL) == DRAFTER_EINVALID_INPUT);
+
+    drafter_free_result(result);
+    free(out);
+
+    return 0;
+}
+
+int test_parse_arena_allocated()
+{
+    drafter_result* heapResult = NULL;
+    drafter_result* arenaResult = NULL;
+
+    drafter_parse_options* parseOptions = drafter_init_parse_options();
+    REQUIRE(drafter_parse_blueprint(source, &heapResult, parseOptions) == 0);
+
+    drafter_set_arena_allocated(parseOptions);
+    REQUIRE(drafter_parse_blueprint(source, &arenaResult, parseOptions) == 0);
+    drafter_free_parse_options(parseOptions);
+
+    REQUIRE(heapResult);
+    REQUIRE(arenaResult);
+
+    char* heapOut = drafter_serialize(heapResult, NULL);
+    char* arenaOut = drafter_serialize(arenaResult, NULL);
+
+    REQUIRE(heapOut);
+    REQUIRE(arenaOut);
+    REQUIRE(strcmp(heapOut, arenaOut) == 0);
+
+    drafter_free_result(heapResult);
+    drafter_free_result(arenaResult);
+    free(heapOut);
+    free(arenaOut);
+
+    return 0;
+}
+
+const char* groupsSource = "# API\n"
+                           "# Group A\n"
+                           "## /a\n"
+                           "### GET\n"
+                           "+ Response 200 (application/json)\n"
+                           "    + Attributes (B)\n"
+                           "# Group B\n"
+                           "## /b\n"
+                           "### GET\n"
+                           "+ Response 200\n"
+                           "# Data Structures\n"
+                           "## B (object)\n"
+                           "+ b: 42 (number)\n";
+
+int test_parse_parallel_conversion()
+{
+    drafter_result* sequentialResult = NULL;
+    drafter_result* parallelResult = NULL;
+
+    drafter_parse_options* parseOptions = drafter_init_parse_options();
+    REQUIRE(drafter_parse_blueprint(groupsSource, &sequentialResult, parseOptions) == 0);
+
+    drafter_set_parallel_conversion(parseOptions);
+    REQUIRE(drafter_parse_blueprint(groupsSource, &parallelResult, parseOptions) == 0);
+
+    drafter_free_result(parallelResult);
+    drafter_set_arena_allocated(parseOptions);
+    REQUIRE(drafter_parse_blueprint(groupsSource, &parallelResult, parseOptions) == 0);
+    drafter_free_parse_options(parseOptions);
+
+    REQUIRE(sequentialResult);
+    REQUIRE(parallelResult);
+
+    char* sequentialOut = drafter_serialize(sequentialResult, NULL);
+    char* parallelOut = drafter_serialize(parallelResult, NULL);
+
+    REQUIRE(sequentialOut);
+    REQUIRE(parallelOut);
+    REQUIRE(strcmp(sequentialOut, parallelOut) == 0);
+
+    drafter_free_result(sequentialResult);
+    drafter_free_result(parallelResult);
+    free(sequentialOut);
+    free(parallelOut);
+
+    return 0;
+}
+
+const char* recursiveSource = "# API\n"
+                              "## GET /tree\n"
+                              "+ Response 200 (application/json)\n"
+                              "    + Attributes (Tree)\n"
+                              "# Data Structures\n"
+                              "## Tree (object)\n"
+                              "+ children (array[Tree])\n"
+                              "+ parent (Tree)\n";
+
+int test_parse_schema_definitions()
+{
+    drafter_result* inlinedResult = NULL;
+    drafter_result* definitionsResult = NULL;
+
+    drafter_parse_options* parseOptions = drafter_init_parse_options();
+    REQUIRE(drafter_parse_blueprint(recursiveSource, &inlinedResult, parseOptions) == 0);
+
+    drafter_set_schema_definitions(parseOptions);
+    REQUIRE(drafter_parse_blueprint(recursiveSource, &definitionsResult, parseOptions) == 0);
+    drafter_free_parse_options(parseOptions);
+
+    REQUIRE(inlinedResult);
+    REQUIRE(definitionsResult);
+
+    char* inlinedOut = drafter_serialize(inlinedResult, NULL);
+    char* definitionsOut = drafter_serialize(definitionsResult, NULL);
+
+    REQUIRE(inlinedOut);
+    REQUIRE(definitionsOut);
+    REQUIRE(strstr(inlinedOut, "#/definitions/Tree") == NULL);
+    REQUIRE(strstr(definitionsOut, "#/definitions/Tree") != NULL);
+
+    drafter_free_result(inlinedResult);
+    drafter_free_result(definitionsResult);
+    free(inlinedOut);
+    free(definitionsOut);
+
+    return 0;
+}
+
 int test_parse_to_string()
 {
 
@@ -103,6 +269,30 @@ int test_validation()
     return 0;
 }
 
+int test_validation_arena()
+{
+    drafter_parse_options* parseOptions = drafter_init_parse_options();
+    drafter_set_arena_allocated(parseOptions);
+    drafter_result* result = NULL;
+
+    int status = drafter_check_blueprint(source_warning, &result, parseOptions);
+    drafter_free_parse_options(parseOptions);
+
+    REQUIRE(status == 0);
+    REQUIRE(result != 0);
+
+    drafter_serialize_options* options = drafter_init_serialize_options();
+    char* out = drafter_serialize(result, options);
+    drafter_free_serialize_options(options);
+
+    REQUIRE(out);
+    REQUIRE_INCLUDES(warning, out);
+
+    drafter_free_result(result);
+    free(out);
+    return 0;
+}
+
 int test_validation_default()
 {
     REQUIRE(DRAFTER_OK == drafter_check_blueprint(source, NULL, NULL));
@@ -214,8 +404,13 @@ int main()
 {
     REQUIRE(test_parse_and_serialize() == 0);
     REQUIRE(test_parse_to_string() == 0);
+    REQUIRE(test_serialize_to_callback() == 0);
+    REQUIRE(test_parse_arena_allocated() == 0);
+    REQUIRE(test_parse_parallel_conversion() == 0);
+    REQUIRE(test_parse_schema_definitions() == 0);
     REQUIRE(test_version() == 0);
     REQUIRE(test_validation() == 0);
+    REQUIRE(test_validation_arena() == 0);
     REQUIRE(test_parse_to_string_requiring_name() == 0);
     REQUIRE(test_validation_default() == 0);
     REQUIRE(test_blueprint_to_serialized_elements_default() == 0);
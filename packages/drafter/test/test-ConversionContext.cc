@@ -0,0 +1,158 @@
+//
+//  test/test-ConversionContext.cc
+//  test-libdrafter
+//
+//  Copyright (c) 2020 Apiary Inc. All rights reserved.
+//
+
+#include <catch2/catch.hpp>
+
+#include "ConversionContext.h"
+#include "refract/Element.h"
+#include "snowcrash.h"
+
+using namespace drafter;
+
+namespace
+{
+    snowcrash::Warning makeWarning(const std::string& message, int code, std::size_t location)
+    {
+        mdp::CharactersRangeSet ranges;
+        ranges.push_back(mdp::CharactersRange(location, 3));
+        return snowcrash::Warning(message, code, ranges);
+    }
+}
+
+SCENARIO("Conversion warnings are deduplicated", "[ConversionContext]")
+{
+    GIVEN("a conversion context")
+    {
+        ConversionContext context("");
+
+        WHEN("warnings are added, some of them repeatedly")
+        {
+            context.warn(makeWarning("first", 1, 0));
+            context.warn(makeWarning("second", 1, 0));
+            context.warn(makeWarning("first", 1, 0));
+            context.warn(makeWarning("first", 2, 0));
+            context.warn(makeWarning("first", 1, 4));
+            context.warn(makeWarning("second", 1, 0));
+
+            THEN("each distinct warning is kept once, in order of first occurrence")
+            {
+                const auto& warnings = context.warnings();
+                REQUIRE(warnings.size() == 4);
+
+                REQUIRE(warnings[0].message == "first");
+                REQUIRE(warnings[1].message == "second");
+                REQUIRE(warnings[2].code == 2);
+                REQUIRE(warnings[3].location[0].location == 4);
+            }
+        }
+    }
+}
+
+SCENARIO("Forked conversion contexts share the type registry", "[ConversionContext]")
+{
+    GIVEN("a conversion context with a registered type and a warning")
+    {
+        ConversionContext context("# API\n");
+
+        auto named = refract::make_empty<refract::ObjectElement>();
+        named->meta().set("id", refract::from_primitive("Registered by test-ConversionContext"));
+        REQUIRE(context.typeRegistry().add(std::move(named)));
+
+        context.warn(makeWarning("first", 1, 0));
+
+        WHEN("it is forked and the fork warns")
+        {
+            ConversionContext fork(context, nullptr);
+
+            fork.warn(makeWarning("second", 1, 0));
+            fork.warn(makeWarning("first", 1, 0));
+
+            THEN("the fork finds the registered type")
+            {
+                REQUIRE(fork.isFork());
+                REQUIRE(!context.isFork());
+                REQUIRE(&fork.typeRegistry() == &context.typeRegistry());
+                REQUIRE(fork.typeRegistry().find(std::string("Registered by test-ConversionContext")));
+                REQUIRE(&fork.newlineIndices() == &context.newlineIndices());
+            }
+
+            THEN("warnings of the fork are kept apart until merged")
+            {
+                REQUIRE(context.warnings().size() == 1);
+                REQUIRE(fork.warnings().size() == 2);
+
+                context.merge(fork);
+
+                const auto& warnings = context.warnings();
+                REQUIRE(warnings.size() == 2);
+                REQUIRE(warnings[0].message == "first");
+                REQUIRE(warnings[1].message == "second");
+            }
+        }
+    }
+}
+
+SCENARIO("Generated assets are keyed by content without source maps", "[ConversionContext][GeneratedAssets]")
+{
+    using namespace refract;
+
+    GIVEN("a conversion context and two equal data structures with different source maps")
+    {
+        ConversionContext context("");
+
+        auto first = make_element<ObjectElement>(make_element<MemberElement>("id", from_primitive(42)));
+        first->attributes().set(
+            "sourceMap", make_element<SourceMapElement>(std::vector<dsd::SourceMap::Range>{ { 3, 5 } }));
+
+        auto second = make_element<ObjectElement>(make_element<MemberElement>("id", from_primitive(42)));
+
+        const auto key = GeneratedAssets::keyOf(*first);
+
+        THEN("their keys have the same hash")
+        {
+            REQUIRE(key.hash == GeneratedAssets::keyOf(*second).hash);
+        }
+
+        WHEN("a body is added under the key")
+        {
+            auto& assets = context.generatedAssets();
+            REQUIRE(!assets.find(GeneratedAssets::Body, key));
+            assets.add(GeneratedAssets::Body, key, "{\"id\":42}");
+
+            THEN("it is found for the equal data structure")
+            {
+                const std::string* body = assets.find(GeneratedAssets::Body, GeneratedAssets::keyOf(*second));
+                REQUIRE(body);
+                REQUIRE(*body == "{\"id\":42}");
+            }
+
+            THEN("it is found after the data structure it was added for is gone")
+            {
+                first.reset();
+                REQUIRE(assets.find(GeneratedAssets::Body, GeneratedAssets::keyOf(*second)));
+            }
+
+            THEN("it is not found for a data structure with different content")
+            {
+                auto other = make_element<ObjectElement>(make_element<MemberElement>("id", from_primitive(43)));
+                REQUIRE(!assets.find(GeneratedAssets::Body, GeneratedAssets::keyOf(*other)));
+            }
+
+            THEN("no schema is found under the key")
+            {
+                REQUIRE(!assets.find(GeneratedAssets::Schema, key));
+            }
+
+            THEN("hits and misses are counted")
+            {
+                assets.find(GeneratedAssets::Body, key);
+                REQUIRE(assets.hits() == 1);
+                REQUIRE(assets.misses() == 1);
+            }
+        }
+    }
+}
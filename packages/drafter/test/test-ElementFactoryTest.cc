@@ -1,7 +1,7 @@
 #include <catch2/catch.hpp>
 
 #include "refract/Element.h"
-#include "refract/TypeQueryVisitor.h"
+#include "refract/ElementUtils.h"
 
 #include "RefractElementFactory.h"
 
@@ -13,7 +13,7 @@ TEST_CASE("Create empty primitive element", "[ElementFactory]")
     const RefractElementFactory& factory = FactoryFromType(mson::StringTypeName);
     auto e = factory.Create(std::string(), eValue);
 
-    StringElement* str = TypeQueryVisitor::as<StringElement>(e.get());
+    StringElement* str = get<StringElement>(e.get());
     REQUIRE(str != NULL);
     REQUIRE(str->empty());
     REQUIRE(str->meta().empty());
@@ -26,7 +26,7 @@ TEST_CASE("Create primitive element w/ value", "[ElementFactory]")
     const RefractElementFactory& factory = FactoryFromType(mson::NumberTypeName);
     auto e = factory.Create("42", eValue);
 
-    NumberElement* number = TypeQueryVisitor::as<NumberElement>(e.get());
+    NumberElement* number = get<NumberElement>(e.get());
     REQUIRE(number != NULL);
     REQUIRE(!number->empty());
     REQUIRE(number->meta().empty());
@@ -39,7 +39,7 @@ TEST_CASE("Create primitive element w/ sample", "[ElementFactory]")
     const RefractElementFactory& factory = FactoryFromType(mson::NumberTypeName);
     auto e = factory.Create("42", eSample);
 
-    NumberElement* number = TypeQueryVisitor::as<NumberElement>(e.get());
+    NumberElement* number = get<NumberElement>(e.get());
     REQUIRE(number != NULL);
     REQUIRE(number->empty());
     REQUIRE(number->meta().empty());
@@ -54,7 +54,7 @@ TEST_CASE("Create primitive element w/ element", "[ElementFactory]")
     const RefractElementFactory& factory = FactoryFromType(mson::NumberTypeName);
     auto e = factory.Create("NAMED", eElement);
 
-    NumberElement* number = TypeQueryVisitor::as<NumberElement>(e.get());
+    NumberElement* number = get<NumberElement>(e.get());
     REQUIRE(number != NULL);
     REQUIRE(number->empty());
     REQUIRE(number->meta().empty());
@@ -67,7 +67,7 @@ TEST_CASE("Create empty complex element", "[ElementFactory]")
     const RefractElementFactory& factory = FactoryFromType(mson::EnumTypeName);
     auto e = factory.Create(std::string(), eValue);
 
-    EnumElement* enm = TypeQueryVisitor::as<EnumElement>(e.get());
+    EnumElement* enm = get<EnumElement>(e.get());
     REQUIRE(enm != NULL);
     REQUIRE(enm->empty());
     REQUIRE(enm->meta().empty());
@@ -80,7 +80,7 @@ TEST_CASE("Create complex named element", "[ElementFactory]")
     const RefractElementFactory& factory = FactoryFromType(mson::ObjectTypeName);
     auto e = factory.Create("NAMED", eElement);
 
-    ObjectElement* enm = TypeQueryVisitor::as<ObjectElement>(e.get());
+    ObjectElement* enm = get<ObjectElement>(e.get());
     REQUIRE(enm != NULL);
     REQUIRE(enm->empty());
     REQUIRE(enm->meta().empty());
@@ -93,7 +93,7 @@ TEST_CASE("Create element as generic", "[ElementFactory]")
     const RefractElementFactory& factory = FactoryFromType(mson::EnumTypeName);
     auto e = factory.Create("Enumerator", eSample);
 
-    StringElement* generic = TypeQueryVisitor::as<StringElement>(e.get());
+    StringElement* generic = get<StringElement>(e.get());
     REQUIRE(generic != NULL);
     REQUIRE(!generic->empty());
     REQUIRE(generic->meta().empty());
@@ -0,0 +1,105 @@
+//
+//  test/test-NamedTypesRegistry.cc
+//  test-libdrafter
+//
+//  Copyright (c) 2020 Apiary Inc. All rights reserved.
+//
+
+#include <catch2/catch.hpp>
+
+#include "NamedTypesRegistry.h"
+
+#include <cstdio>
+
+using namespace drafter;
+
+namespace
+{
+    using Names = std::vector<std::string>;
+    using Dependencies = std::vector<Names>;
+
+    Names sorted(const Names& names, const Dependencies& dependencies)
+    {
+        Names result;
+        for (std::size_t i : SortByDependencies(names, dependencies))
+            result.push_back(names[i]);
+        return result;
+    }
+
+    std::string chainLink(std::size_t i)
+    {
+        char buffer[8];
+        std::snprintf(buffer, sizeof(buffer), "T%03zu", i);
+        return buffer;
+    }
+} // namespace
+
+SCENARIO("Named types are ordered by their dependencies", "[NamedTypesRegistry]")
+{
+    GIVEN("named types declared before the types they depend on")
+    {
+        // C (B), B (A), A (object)
+        const Names names{ "C", "B", "A" };
+        const Dependencies dependencies{ { "B" }, { "A" }, { "object" } };
+
+        THEN("every one of them follows its dependencies")
+        {
+            REQUIRE(sorted(names, dependencies) == (Names{ "A", "B", "C" }));
+        }
+    }
+
+    GIVEN("a diamond of named types")
+    {
+        // D (B) with member of C, B (A), C (A), A (object)
+        const Names names{ "D", "C", "B", "A" };
+        const Dependencies dependencies{ { "B", "C" }, { "A" }, { "A" }, {} };
+
+        THEN("the shared base comes first and siblings are ordered by name")
+        {
+            REQUIRE(sorted(names, dependencies) == (Names{ "A", "B", "C", "D" }));
+        }
+    }
+
+    GIVEN("a deep inheritance chain ordered against the names")
+    {
+        // T000 (T001), T001 (T002), ..., T99999 (object), deeper than
+        // recursion per named type would get on a default native stack
+        const std::size_t depth = 100000;
+
+        Names names;
+        Dependencies dependencies;
+        for (std::size_t i = 0; i < depth; ++i) {
+            names.push_back(chainLink(i));
+            dependencies.push_back(i + 1 < depth ? Names{ chainLink(i + 1) } : Names{});
+        }
+
+        THEN("the chain is ordered from its root")
+        {
+            const Names expected(names.rbegin(), names.rend());
+            REQUIRE(sorted(names, dependencies) == expected);
+        }
+    }
+
+    GIVEN("named types recursively referencing each other through members")
+    {
+        // User with member of Group, Group with member of User, Admin (User)
+        const Names names{ "User", "Group", "Admin" };
+        const Dependencies dependencies{ { "Group" }, { "User" }, { "User" } };
+
+        THEN("the cycle is kept together, ordered by name, before its dependents")
+        {
+            REQUIRE(sorted(names, dependencies) == (Names{ "Group", "User", "Admin" }));
+        }
+    }
+
+    GIVEN("named types not depending on each other")
+    {
+        const Names names{ "b", "c", "a" };
+        const Dependencies dependencies{ { "string" }, {}, { "number" } };
+
+        THEN("they are ordered by name")
+        {
+            REQUIRE(sorted(names, dependencies) == (Names{ "a", "b", "c" }));
+        }
+    }
+}
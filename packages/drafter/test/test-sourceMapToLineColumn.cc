@@ -161,3 +161,35 @@ TEST_CASE("GetLinesEndIndex - check indexing utf8 chars", "[sourcemap utils]")
     const auto out = GetLinesEndIndex(input);
     REQUIRE(std::equal(expected.begin(), expected.end(), out.begin()));
 }
+
+TEST_CASE("GetLinesEndIndex - check indexing ascii", "[sourcemap utils]")
+{
+    const static std::string input = "ab\n\ncd\nef"; // 0, 3, 4, 7
+    const NewLinesIndex expected = { 0, 3, 4, 7 };
+
+    REQUIRE(GetLinesEndIndex(input) == expected);
+}
+
+TEST_CASE("GetLinesEndIndex - check indexing mixed ascii and utf8 runs", "[sourcemap utils]")
+{
+    const static std::string input = "a\n€€\nb¢\n\n"; // 0, 2, 5, 8, 9
+    const NewLinesIndex expected = { 0, 2, 5, 8, 9 };
+
+    REQUIRE(GetLinesEndIndex(input) == expected);
+}
+
+TEST_CASE("GetLinesEndIndex - malformed sequence swallows newline as when decoding", "[sourcemap utils]")
+{
+    const static std::string input = "a\xC3\nb\n"; // lead octet consumes the first newline
+    const NewLinesIndex expected = { 0, 4 };
+
+    REQUIRE(GetLinesEndIndex(input) == expected);
+}
+
+TEST_CASE("GetLinesEndIndex - malformed sequence swallows newline and continues past it", "[sourcemap utils]")
+{
+    const static std::string input = "\xE2\nab\n"; // lead octet consumes the newline and `a`
+    const NewLinesIndex expected = { 0, 3 };
+
+    REQUIRE(GetLinesEndIndex(input) == expected);
+}
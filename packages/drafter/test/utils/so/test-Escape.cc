@@ -0,0 +1,129 @@
+//
+//  test/utils/so/test-Escape.cc
+//  test-librefract
+//
+//  Copyright (c) 2020 Apiary Inc. All rights reserved.
+//
+
+#include <catch2/catch.hpp>
+
+#include <sstream>
+#include <string>
+#include "utils/so/Escape.h"
+#include "utils/so/OutputBuffer.h"
+
+using namespace drafter;
+using namespace utils;
+using namespace so;
+
+namespace
+{
+    bool is_json_special(unsigned char c)
+    {
+        return c < 0x20 || c == '"' || c == '\\';
+    }
+
+    bool is_yaml_special(unsigned char c)
+    {
+        return c < 0x20 || c >= 0x7F || c == '"' || c == '\\';
+    }
+
+    std::string escaped_json(const std::string& str)
+    {
+        std::ostringstream out;
+        {
+            output_buffer buffer(out);
+            escape_json(buffer, str);
+        }
+        return out.str();
+    }
+
+    std::string escaped_yaml(const std::string& str)
+    {
+        std::ostringstream out;
+        {
+            output_buffer buffer(out);
+            escape_yaml(buffer, str);
+        }
+        return out.str();
+    }
+} // namespace
+
+SCENARIO("Special bytes are found at any offset", "[simple-object][escape]")
+{
+    // longer than two blocks of the widest vectorized scan
+    const std::size_t length = 71;
+
+    for (unsigned b = 0; b < 0x100; ++b) {
+        const unsigned char byte = static_cast<unsigned char>(b);
+
+        for (std::size_t offset = 0; offset < length; ++offset) {
+            std::string str(length, 'a');
+            str[offset] = static_cast<char>(byte);
+
+            const char* first = str.data();
+            const char* last = str.data() + str.size();
+
+            INFO("byte: " << b << ", offset: " << offset);
+            REQUIRE(find_json_special(first, last) == (is_json_special(byte) ? first + offset : last));
+            REQUIRE(find_yaml_special(first, last) == (is_yaml_special(byte) ? first + offset : last));
+        }
+    }
+}
+
+SCENARIO("Strings are escaped for JSON", "[simple-object][escape][json]")
+{
+    REQUIRE(escaped_json("") == "");
+    REQUIRE(escaped_json("Hello world!") == "Hello world!");
+    REQUIRE(escaped_json("\"quoted\" \\ back") == "\\\"quoted\\\" \\\\ back");
+    REQUIRE(escaped_json("\b\f\n\r\t") == "\\b\\f\\n\\r\\t");
+    REQUIRE(escaped_json(std::string("\0\x01\x1f", 3)) == "\\u0000\\u0001\\u001f");
+    REQUIRE(escaped_json("\x7f žluťoučký kůň") == "\x7f žluťoučký kůň");
+
+    const std::string run(100, 'x');
+    REQUIRE(escaped_json(run + "\n" + run + "\"") == run + "\\n" + run + "\\\"");
+}
+
+SCENARIO("Strings are escaped for YAML", "[simple-object][escape][yaml]")
+{
+    REQUIRE(escaped_yaml("") == "");
+    REQUIRE(escaped_yaml("Hello world!") == "Hello world!");
+    REQUIRE(escaped_yaml("\"quoted\" \\ back") == "\\\"quoted\\\" \\\\ back");
+    REQUIRE(escaped_yaml(std::string("\0\a\b\t\n\v\f\r\x1b", 9)) == "\\0\\a\\b\\t\\n\\v\\f\\r\\e");
+    REQUIRE(escaped_yaml("\x01\x7f") == "\\x01\\x7F");
+    REQUIRE(escaped_yaml("žluťoučký kůň") == "žluťoučký kůň");
+    REQUIRE(escaped_yaml("\xc2\x85\xc2\xa0\xe2\x80\xa8\xe2\x80\xa9") == "\\N\\_\\L\\P");
+    REQUIRE(escaped_yaml("\xef\xbb\xbf") == "\\uFEFF");
+
+    // invalid sequences are replaced
+    REQUIRE(escaped_yaml("a\xff") == "a\xef\xbf\xbd");
+    REQUIRE(escaped_yaml("a\xe2\x80") == "a\xef\xbf\xbd");
+
+    const std::string run(100, 'x');
+    REQUIRE(escaped_yaml(run + "ř" + run + "\t") == run + "ř" + run + "\\t");
+}
+
+SCENARIO("Output buffer preserves order of small and large writes", "[simple-object][escape]")
+{
+    std::ostringstream out;
+    std::string expected;
+
+    {
+        output_buffer buffer(out);
+
+        const std::string large(output_buffer::capacity + 1, 'L');
+        for (int i = 0; i < 3; ++i) {
+            buffer.append('c');
+            buffer.append("literal");
+            buffer.append(large);
+            buffer.fill(' ', output_buffer::capacity / 2 + 1);
+
+            expected += 'c';
+            expected += "literal";
+            expected += large;
+            expected += std::string(output_buffer::capacity / 2 + 1, ' ');
+        }
+    }
+
+    REQUIRE(out.str() == expected);
+}
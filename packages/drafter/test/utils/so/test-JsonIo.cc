@@ -482,6 +482,70 @@ SCENARIO("Serialize a utils::so::Value holding numbers json", "[simple-object][j
             }
         }
     }
+
+    GIVEN("a Number{-1234567890123}")
+    {
+        Value value(mpark::in_place_type_t<Number>{}, std::int64_t{ -1234567890123 });
+
+        WHEN("it is serialized into stringstream as JSON")
+        {
+            std::stringstream ss;
+            serialize_json(ss, value);
+
+            THEN("the stringstream contains: -1234567890123")
+            {
+                REQUIRE("-1234567890123" == ss.str());
+            }
+        }
+    }
+
+    GIVEN("a Number{2.5}")
+    {
+        Value value(mpark::in_place_type_t<Number>{}, 2.5);
+
+        WHEN("it is serialized into stringstream as JSON")
+        {
+            std::stringstream ss;
+            serialize_json(ss, value);
+
+            THEN("the stringstream contains: 2.5")
+            {
+                REQUIRE("2.5" == ss.str());
+            }
+        }
+    }
+
+    GIVEN("a Number{inf}")
+    {
+        Value value(mpark::in_place_type_t<Number>{}, std::numeric_limits<double>::infinity());
+
+        WHEN("it is serialized into stringstream as JSON")
+        {
+            std::stringstream ss;
+            serialize_json(ss, value);
+
+            THEN("the stringstream contains: null")
+            {
+                REQUIRE("null" == ss.str());
+            }
+        }
+    }
+
+    GIVEN("a Number{`1.0e3`} literal")
+    {
+        Value value(mpark::in_place_type_t<Number>{}, std::string("1.0e3"));
+
+        WHEN("it is serialized into stringstream as JSON")
+        {
+            std::stringstream ss;
+            serialize_json(ss, value);
+
+            THEN("the stringstream contains the literal verbatim")
+            {
+                REQUIRE("1.0e3" == ss.str());
+            }
+        }
+    }
 }
 
 SCENARIO("Serialize a utils::so::Value holding deep objects into indented json", "[simple-object][json]")